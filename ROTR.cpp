@@ -6,49 +6,15 @@
 #include <cstdint>
 #include <iomanip>
 #include <cmath>
+#include <algorithm>
+
+#include "SHA.h"
 
 // ============ Global Variables ============
-std::string g_delay = "normal";
+// g_delay, clearScreen(), bits(), hex() and rotr() come from libsha256
 bool g_showBinary = true;
 bool g_showHex = false;
 
-// ============ Utility Functions ============
-
-void clearScreen() {
-    std::cout << "\033[2J\033[1;1H";
-}
-
-void delay(int ms) {
-    if (g_delay != "nodelay") {
-        std::this_thread::sleep_for(std::chrono::milliseconds(ms));
-    }
-}
-
-void waitForEnter() {
-    if (g_delay == "enter") {
-        std::cin.get();
-    }
-}
-
-std::string bits(uint32_t x) {
-    return std::bitset<32>(x).to_string();
-}
-
-std::string hex(uint32_t x) {
-    std::stringstream ss;
-    ss << std::hex << std::setfill('0') << std::setw(8) << x;
-    return ss.str();
-}
-
-// ============ Rotate Right Function ============
-
-uint32_t rotr(int n, uint32_t x) {
-    uint32_t mask = 0xFFFFFFFF;
-    uint32_t right = (x >> n) & mask;
-    uint32_t left = (x << (32 - n)) & mask;
-    return right | left;
-}
-
 // ============ Visualization with Step-by-Step Explanation ============
 
 void showRotrWithExplanation(uint32_t x, int max_n) {
@@ -153,7 +119,7 @@ void showRotrSimple(uint32_t x, int n) {
         std::cout << "ROTR " << s << ": " << bits(rotr(i, x)) << std::endl;
         
         if (g_delay == "enter") {
-            std::cin.get();
+            waitForEnter();
         } else {
             delay(100);
         }
@@ -262,6 +228,9 @@ int main(int argc, char* argv[]) {
         std::cin.get();
     }
     
+    // Compose each frame in memory; only the changed cells are redrawn
+    frame_renderer().attach();
+
     // Show detailed explanation for first 5 steps
     int detailed = std::min(5, n);
     if (detailed > 0) {
@@ -280,7 +249,7 @@ int main(int argc, char* argv[]) {
             std::cout << "ROTR " << s << ": " << bits(rotr(i, x)) << std::endl;
             
             if (g_delay == "enter") {
-                std::cin.get();
+                waitForEnter();
             } else {
                 delay(50); // Faster for remaining steps
             }
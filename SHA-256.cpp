@@ -5,9 +5,10 @@
 #include <csignal>
 #include <cstdlib>
 
+#include "SHA.h"
+
 // ============ Global Variables ============
 std::string g_input;
-std::string g_delay = "normal";
 std::string g_type;
 std::vector<uint8_t> g_bytes;
 std::string g_message;
@@ -16,12 +17,6 @@ std::string g_block;
 int g_block_number = 0;
 std::vector<uint32_t> g_hash;
 
-// Forward declarations of functions from sha256lib
-std::string input_type(const std::string& input);
-std::vector<uint8_t> bytes(const std::string& input, const std::string& type);
-void delay(const std::string& speed);
-void clearScreen();
-
 // Signal handler for Ctrl-C
 void signalHandler(int signum) {
     std::cout << "\nInterrupted. Exiting cleanly." << std::endl;
@@ -183,19 +178,12 @@ int main(int argc, char* argv[]) {
     showMessage();
 
     // 2. Padding
+    g_message = padding(g_message);
     showPadding();
-    // In a full implementation, we would call padding() here
-    // g_message = padding(g_message);
 
     // 3. Message Blocks
+    g_blocks = split(g_message, 512);
     showBlocks();
-    // In a full implementation, we would split the padded message
-    // g_blocks = split(g_message, 512);
-
-    // For demonstration, create a dummy block
-    if (g_blocks.empty()) {
-        g_blocks.push_back(g_message + std::string(512 - g_message.length(), '0'));
-    }
 
     // 4-5. Process each block
     for (size_t i = 0; i < g_blocks.size(); i++) {
@@ -208,16 +196,14 @@ int main(int argc, char* argv[]) {
         // 5. Initial Hash Values (only for first block)
         if (i == 0) {
             // Set initial hash values (IV)
-            g_hash = IV; // This would come from sha256lib
+            g_hash.assign(IV.begin(), IV.end());
             showInitialHash();
         }
 
         // 5. Compression
+        std::vector<uint32_t> schedule = calculate_schedule(g_block);
+        g_hash = compression(g_hash, schedule, std::vector<uint32_t>(K.begin(), K.end()));
         showCompression();
-
-        // In a full implementation, we would:
-        // - Calculate schedule: std::vector<uint32_t> schedule = calculate_schedule(g_block);
-        // - Run compression: g_hash = compression(g_hash, schedule, K);
     }
 
     // 6. Final Hash
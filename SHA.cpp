@@ -11,6 +11,19 @@
 #include <cstdint>
 #include <fstream>
 #include <regex>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define SHA256_POSIX_IO 1
+#endif
+
+#include "SHA.h"
 
 // ============ Global Variables ============
 std::string g_delay = "normal";
@@ -18,10 +31,15 @@ std::string g_delay = "normal";
 // ============ Utility Functions ============
 
 void clearScreen() {
+    FrameRenderer& frames = frame_renderer();
+    if (frames.attached()) {
+        frames.begin();
+        return;
+    }
     std::cout << "\033[2J\033[1;1H";
 }
 
-std::string bits(uint32_t x, int n = 32) {
+std::string bits(uint32_t x, int n) {
     if (x >= 0) {
         std::string binary = std::bitset<32>(x).to_string();
         return binary.substr(32 - n, n);
@@ -50,27 +68,19 @@ std::string bitstring(const std::string& str) {
 }
 
 void delay(const std::string& speed) {
-    if (g_delay == "enter") {
-        std::cin.get();
-    } else if (g_delay == "nodelay") {
-        std::this_thread::sleep_for(std::chrono::milliseconds(0));
-    } else {
-        double multiplier = 1.0;
-        if (g_delay == "fast") {
-            multiplier = 0.5;
-        }
+    if (frame_renderer().attached()) frame_renderer().present();
+    playback_clock().wait(speed);
+}
 
-        int sleepTime = 0;
-        if (speed == "fastest") sleepTime = 100 * multiplier;
-        else if (speed == "fast") sleepTime = 200 * multiplier;
-        else if (speed == "normal") sleepTime = 400 * multiplier;
-        else if (speed == "slow") sleepTime = 600 * multiplier;
-        else if (speed == "slowest") sleepTime = 800 * multiplier;
-        else if (speed == "end") sleepTime = 1000 * multiplier;
-        else sleepTime = std::stoi(speed);
+// In "enter" mode frames only stop at delay(speed) and waitForEnter()
+void delay(int ms) {
+    if (frame_renderer().attached()) frame_renderer().present();
+    if (g_delay != "enter") playback_clock().wait(ms);
+}
 
-        std::this_thread::sleep_for(std::chrono::milliseconds(sleepTime));
-    }
+void waitForEnter() {
+    if (frame_renderer().attached()) frame_renderer().present();
+    if (g_delay == "enter") playback_clock().wait(0);
 }
 
 std::string input_type(const std::string& input) {
@@ -207,14 +217,17 @@ uint32_t maj(uint32_t x, uint32_t y, uint32_t z) {
 
 std::string padding(const std::string& message) {
     size_t l = message.size();  // size of message (in bits)
-    int k = (448 - static_cast<int>(l) - 1) % 512;
-    if (k < 0) k += 512;
+    size_t k = (447 - l % 512 + 512) % 512;
     
-    std::string l64 = bits(l, 64);
+    std::string l64 = std::bitset<64>(l).to_string();
     return message + "1" + std::string(k, '0') + l64;
 }
 
-std::vector<std::string> split(const std::string& message, int size = 512) {
+uint64_t padded_blocks(uint64_t length) {
+    return (length + 9 + 63) / 64;
+}
+
+std::vector<std::string> split(const std::string& message, int size) {
     std::vector<std::string> blocks;
     for (size_t i = 0; i < message.length(); i += size) {
         blocks.push_back(message.substr(i, size));
@@ -222,6 +235,32 @@ std::vector<std::string> split(const std::string& message, int size = 512) {
     return blocks;
 }
 
+// ============ Byte Order ============
+
+// Load a 32-bit big-endian word from 4 bytes
+static inline uint32_t load_be32(const uint8_t* p) {
+    return (static_cast<uint32_t>(p[0]) << 24) |
+           (static_cast<uint32_t>(p[1]) << 16) |
+           (static_cast<uint32_t>(p[2]) << 8) |
+           static_cast<uint32_t>(p[3]);
+}
+
+// Store a 32-bit word as 4 big-endian bytes
+static inline void store_be32(uint8_t* p, uint32_t x) {
+    p[0] = static_cast<uint8_t>(x >> 24);
+    p[1] = static_cast<uint8_t>(x >> 16);
+    p[2] = static_cast<uint8_t>(x >> 8);
+    p[3] = static_cast<uint8_t>(x);
+}
+
+// Store a 64-bit value as 8 big-endian bytes
+static inline void store_be64(uint8_t* p, uint64_t x) {
+    for (int i = 7; i >= 0; i--) {
+        p[i] = static_cast<uint8_t>(x);
+        x >>= 8;
+    }
+}
+
 // ============ Message Schedule ============
 
 std::vector<uint32_t> calculate_schedule(const std::string& block) {
@@ -244,41 +283,28 @@ std::vector<uint32_t> calculate_schedule(const std::string& block) {
     return schedule;
 }
 
-// ============ Constants ============
+// Same as above, but reads the 16 words straight from a 64-byte block
+std::vector<uint32_t> calculate_schedule(const uint8_t* block) {
+    std::vector<uint32_t> schedule(64);
 
-// Constants = Cube roots of the first 64 prime numbers (first 32 bits of the fractional part)
-const std::vector<uint32_t> K = []() {
-    std::vector<uint32_t> constants;
-    int primes[] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53, 
-                    59, 61, 67, 71, 73, 79, 83, 89, 97, 101, 103, 107, 109, 113, 
-                    127, 131, 137, 139, 149, 151, 157, 163, 167, 173, 179, 181, 
-                    191, 193, 197, 199, 211, 223, 227, 229, 233, 239, 241, 251, 
-                    257, 263, 269, 271, 277, 281, 283, 293, 307, 311};
-    
-    for (int prime : primes) {
-        double cubeRoot = std::pow(prime, 1.0 / 3.0);
-        double fractional = cubeRoot - std::floor(cubeRoot);
-        uint32_t value = static_cast<uint32_t>(fractional * std::pow(2, 32));
-        constants.push_back(value);
+    for (int i = 0; i < 16; i++) {
+        schedule[i] = load_be32(block + i * 4);
     }
-    return constants;
-}();
+
+    for (int i = 16; i <= 63; i++) {
+        schedule[i] = add(sigma1(schedule[i - 2]), 
+                          schedule[i - 7], 
+                          sigma0(schedule[i - 15]), 
+                          schedule[i - 16]);
+    }
+
+    return schedule;
+}
 
 // ============ Compression ============
 
-// Initial Hash Values = Square roots of the first 8 prime numbers (first 32 bits of the fractional part)
-const std::vector<uint32_t> IV = []() {
-    std::vector<uint32_t> initial;
-    int primes[] = {2, 3, 5, 7, 11, 13, 17, 19};
-    
-    for (int prime : primes) {
-        double squareRoot = std::sqrt(prime);
-        double fractional = squareRoot - std::floor(squareRoot);
-        uint32_t value = static_cast<uint32_t>(fractional * std::pow(2, 32));
-        initial.push_back(value);
-    }
-    return initial;
-}();
+// K (cube roots of the first 64 primes) and IV (square roots of the first
+// 8 primes) are compile-time tables, see sha256_constants.h
 
 std::vector<uint32_t> compression(const std::vector<uint32_t>& initial, 
                                   const std::vector<uint32_t>& schedule,
@@ -324,65 +350,445 @@ std::vector<uint32_t> compression(const std::vector<uint32_t>& initial,
     return hash;
 }
 
-// ============ SHA-256 ============
+// ============ Unrolled Kernel ============
+// The primitives above are kept as separate functions for the step-by-step
+// tools; the kernel below inlines them so the whole block is computed in
+// registers.
+
+#define SHA256_ROTR(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
+#define SHA256_S0(x) (SHA256_ROTR(x, 2) ^ SHA256_ROTR(x, 13) ^ SHA256_ROTR(x, 22))
+#define SHA256_S1(x) (SHA256_ROTR(x, 6) ^ SHA256_ROTR(x, 11) ^ SHA256_ROTR(x, 25))
+#define SHA256_s0(x) (SHA256_ROTR(x, 7) ^ SHA256_ROTR(x, 18) ^ ((x) >> 3))
+#define SHA256_s1(x) (SHA256_ROTR(x, 17) ^ SHA256_ROTR(x, 19) ^ ((x) >> 10))
+#define SHA256_CH(x, y, z) ((z) ^ ((x) & ((y) ^ (z))))
+#define SHA256_MAJ(x, y, z) (((x) & (y)) | ((z) & ((x) | (y))))
+
+// Message schedule word i, kept in a rolling window of 16 words
+#define SHA256_W(i) \
+    ((i) < 16 ? w[i] \
+              : (w[(i) & 15] += SHA256_s1(w[((i) - 2) & 15]) + w[((i) - 7) & 15] + \
+                                SHA256_s0(w[((i) - 15) & 15])))
+
+// One round; instead of shifting a..h the caller rotates the argument order
+#define SHA256_ROUND(a, b, c, d, e, f, g, h, i) \
+    do { \
+        uint32_t t1 = h + SHA256_S1(e) + SHA256_CH(e, f, g) + K[i] + SHA256_W(i); \
+        uint32_t t2 = SHA256_S0(a) + SHA256_MAJ(a, b, c); \
+        d += t1; \
+        h = t1 + t2; \
+    } while (0)
+
+#define SHA256_ROUND8(i) \
+    SHA256_ROUND(a, b, c, d, e, f, g, h, (i) + 0); \
+    SHA256_ROUND(h, a, b, c, d, e, f, g, (i) + 1); \
+    SHA256_ROUND(g, h, a, b, c, d, e, f, (i) + 2); \
+    SHA256_ROUND(f, g, h, a, b, c, d, e, (i) + 3); \
+    SHA256_ROUND(e, f, g, h, a, b, c, d, (i) + 4); \
+    SHA256_ROUND(d, e, f, g, h, a, b, c, (i) + 5); \
+    SHA256_ROUND(c, d, e, f, g, h, a, b, (i) + 6); \
+    SHA256_ROUND(b, c, d, e, f, g, h, a, (i) + 7)
+
+// In-place compression of one 64-byte block into the chaining state.
+// Fully unrolled: every K[i] is a constant and the schedule is a 16-word
+// window on the stack, so no heap allocation or function call per block.
+void compress(std::array<uint32_t, 8>& state, const uint8_t* block) {
+    // message schedule (first 16 words)
+    uint32_t w[16];
+    for (int i = 0; i < 16; i++) {
+        w[i] = load_be32(block + i * 4);
+    }
 
-std::string sha256(const std::string& str) {
-    // 0. Convert String to Binary
-    std::string message = bitstring(str);
+    // state registers
+    uint32_t a = state[0];
+    uint32_t b = state[1];
+    uint32_t c = state[2];
+    uint32_t d = state[3];
+    uint32_t e = state[4];
+    uint32_t f = state[5];
+    uint32_t g = state[6];
+    uint32_t h = state[7];
+
+    // compression function
+    SHA256_ROUND8(0);
+    SHA256_ROUND8(8);
+    SHA256_ROUND8(16);
+    SHA256_ROUND8(24);
+    SHA256_ROUND8(32);
+    SHA256_ROUND8(40);
+    SHA256_ROUND8(48);
+    SHA256_ROUND8(56);
+
+    // add the compressed chunk to the current hash value
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+}
+
+// ============ Backend Dispatch ============
+
+void compress_blocks_scalar(std::array<uint32_t, 8>& state, const uint8_t* data, size_t blocks) {
+    for (size_t i = 0; i < blocks; i++) {
+        compress(state, data + i * 64);
+    }
+}
+
+bool sha256_backend_supported(Sha256Backend backend) {
+    if (backend == Sha256Backend::ShaNi) {
+        return shani_supported();
+    }
+    return true;
+}
 
-    // 1. Preprocessing
-    std::string padded = padding(message);
-    std::vector<std::string> blocks = split(padded, 512);
+const char* sha256_backend_name(Sha256Backend backend) {
+    return backend == Sha256Backend::ShaNi ? "shani" : "scalar";
+}
+
+// Picked once: the fastest supported backend, unless SHA256_BACKEND=scalar
+static Sha256Backend detect_backend() {
+    const char* forced = std::getenv("SHA256_BACKEND");
+    if (forced != nullptr && std::string(forced) == "scalar") {
+        return Sha256Backend::Scalar;
+    }
+    return shani_supported() ? Sha256Backend::ShaNi : Sha256Backend::Scalar;
+}
 
-    // 2. Hash Computation
-    std::vector<uint32_t> hash = IV;
+static Sha256Backend& active_backend() {
+    static Sha256Backend backend = detect_backend();
+    return backend;
+}
 
-    for (const auto& block : blocks) {
-        // Prepare 64 word message schedule
-        std::vector<uint32_t> schedule = calculate_schedule(block);
+Sha256Backend sha256_get_backend() {
+    return active_backend();
+}
 
-        // Remember starting hash values
-        std::vector<uint32_t> initial = hash;
+bool sha256_set_backend(Sha256Backend backend) {
+    if (!sha256_backend_supported(backend)) {
+        return false;
+    }
+    active_backend() = backend;
+    return true;
+}
 
-        // Apply compression function
-        hash = compression(initial, schedule, K);
+void compress_blocks(std::array<uint32_t, 8>& state, const uint8_t* data, size_t blocks) {
+    if (active_backend() == Sha256Backend::ShaNi) {
+        compress_shani(state, data, blocks);
+    } else {
+        compress_blocks_scalar(state, data, blocks);
     }
+}
 
-    // 3. Result
-    std::string result;
+// ============ Streaming Context ============
+
+Sha256Context::Sha256Context() {
+    reset();
+}
+
+Sha256Context::Sha256Context(const std::array<uint32_t, 8>& state, uint64_t length)
+    : hash(state), buffered(0), length(length) {
+}
+
+void Sha256Context::reset() {
+    std::copy(IV.begin(), IV.end(), hash.begin());
+    buffered = 0;
+    length = 0;
+}
+
+void Sha256Context::update(const void* data, size_t size) {
+    const uint8_t* input = static_cast<const uint8_t*>(data);
+    length += size;
+
+    // Top up a partially filled block first
+    if (buffered > 0) {
+        size_t take = std::min(size, 64 - buffered);
+        std::copy(input, input + take, buffer + buffered);
+        buffered += take;
+        input += take;
+        size -= take;
+
+        if (buffered < 64) {
+            return;
+        }
+        compress_blocks(hash, buffer, 1);
+        buffered = 0;
+    }
+
+    // Compress complete blocks straight from the caller's memory
+    size_t blocks = size / 64;
+    compress_blocks(hash, input, blocks);
+    input += blocks * 64;
+    size -= blocks * 64;
+
+    // Keep the leftover bytes for the next update() or final()
+    std::copy(input, input + size, buffer);
+    buffered = size;
+}
+
+void Sha256Context::final(Digest& digest) {
+    // Padding: buffered bytes + 0x80 + zeros + 64-bit bit length.
+    // Spills into a second block when fewer than 9 bytes are left.
+    buffer[buffered] = 0x80;
+    std::fill(buffer + buffered + 1, buffer + 64, 0);
+
+    if (buffered >= 56) {
+        compress_blocks(hash, buffer, 1);
+        std::fill(buffer, buffer + 64, 0);
+    }
+    store_be64(buffer + 56, length * 8);
+    compress_blocks(hash, buffer, 1);
+
+    for (int i = 0; i < 8; i++) {
+        store_be32(digest.data() + i * 4, hash[i]);
+    }
+}
+
+std::string Sha256Context::final() {
+    Digest digest;
+    final(digest);
+    return to_hex(digest);
+}
+
+// ============ Saved State ============
+
+static const uint8_t kSavedMagic[4] = {'S', '2', '5', '6'};
+static const uint8_t kSavedVersion = 1;
+
+size_t Sha256Context::save(uint8_t* out) const {
+    uint8_t* p = out;
+    std::copy(kSavedMagic, kSavedMagic + 4, p);
+    p += 4;
+    *p++ = kSavedVersion;
     for (uint32_t w : hash) {
-        result += hex(w);
+        store_be32(p, w);
+        p += 4;
+    }
+    store_be64(p, length);
+    p += 8;
+    *p++ = static_cast<uint8_t>(buffered);
+    std::copy(buffer, buffer + buffered, p);
+    p += buffered;
+    return static_cast<size_t>(p - out);
+}
+
+std::vector<uint8_t> Sha256Context::save() const {
+    std::vector<uint8_t> out(kSavedMax);
+    out.resize(save(out.data()));
+    return out;
+}
+
+bool Sha256Context::load(const uint8_t* data, size_t size) {
+    const size_t header = 4 + 1 + 32 + 8 + 1;
+    if (size < header || !std::equal(kSavedMagic, kSavedMagic + 4, data) ||
+        data[4] != kSavedVersion) {
+        return false;
+    }
+
+    uint64_t saved_length = 0;
+    for (int i = 0; i < 8; i++) {
+        saved_length = saved_length << 8 | data[37 + i];
+    }
+    size_t saved_buffered = data[45];
+    // the tail is always the part of the message past the last full block
+    if (saved_buffered != saved_length % 64 || size != header + saved_buffered) {
+        return false;
+    }
+
+    for (int i = 0; i < 8; i++) {
+        hash[i] = load_be32(data + 5 + i * 4);
+    }
+    length = saved_length;
+    buffered = saved_buffered;
+    std::copy(data + header, data + size, buffer);
+    return true;
+}
+
+// ============ Digest ============
+
+// The digest is already uniformly distributed, so its first bytes are a
+// good hash on their own
+size_t DigestHash::operator()(const Digest& digest) const {
+    size_t h;
+    std::memcpy(&h, digest.data(), sizeof(h));
+    return h;
+}
+
+void to_hex(const Digest& digest, char* out) {
+    static const char digits[] = "0123456789abcdef";
+    for (uint8_t byte : digest) {
+        *out++ = digits[byte >> 4];
+        *out++ = digits[byte & 0x0F];
     }
+}
+
+std::string to_hex(const Digest& digest) {
+    std::string result(64, '0');
+    to_hex(digest, &result[0]);
     return result;
 }
 
-// ============ Main ============
-
-int main(int argc, char* argv[]) {
-    if (argc > 1) {
-        std::string input = argv[1];
-        std::string type = input_type(input);
-        
-        if (type == "file") {
-            std::ifstream file(input);
-            std::string content((std::istreambuf_iterator<char>(file)),
-                                std::istreambuf_iterator<char>());
-            std::cout << sha256(content) << std::endl;
-        } else {
-            std::string str;
-            if (type == "binary" || type == "hex") {
-                auto byteVec = bytes(input, type);
-                str = std::string(byteVec.begin(), byteVec.end());
-            } else {
-                str = input;
-            }
-            std::cout << sha256(str) << std::endl;
+// ============ SHA-256 ============
+
+std::string sha256(const uint8_t* data, size_t length) {
+    Sha256Context ctx;
+    ctx.update(data, length);
+    return ctx.final();
+}
+
+std::string sha256(const std::string& str) {
+    return sha256(reinterpret_cast<const uint8_t*>(str.data()), str.size());
+}
+
+Digest sha256_digest(const uint8_t* data, size_t length) {
+    Sha256Context ctx;
+    ctx.update(data, length);
+    Digest digest;
+    ctx.final(digest);
+    return digest;
+}
+
+Digest sha256_digest(const std::string& str) {
+    return sha256_digest(reinterpret_cast<const uint8_t*>(str.data()), str.size());
+}
+
+// ============ Double SHA-256 ============
+
+// Hash of a 32-byte digest: always exactly one block with fixed padding
+static void sha256_of_digest(const Digest& first, Digest& out) {
+    uint8_t block[64] = {0};
+    std::copy(first.begin(), first.end(), block);
+    block[32] = 0x80;
+    store_be64(block + 56, 256);
+
+    std::array<uint32_t, 8> state;
+    std::copy(IV.begin(), IV.end(), state.begin());
+    compress_blocks(state, block, 1);
+    for (int i = 0; i < 8; i++) {
+        store_be32(out.data() + i * 4, state[i]);
+    }
+}
+
+Digest sha256d(const uint8_t* data, size_t length) {
+    Digest digest;
+    sha256_of_digest(sha256_digest(data, length), digest);
+    return digest;
+}
+
+Sha256dHeader::Sha256dHeader(const uint8_t* header) {
+    // First 64 bytes never change between nonces: compress them once
+    std::copy(IV.begin(), IV.end(), midstate.begin());
+    compress_blocks(midstate, header, 1);
+
+    // Second block: bytes 64..79, then the padding for an 80-byte message
+    std::fill(tail, tail + 64, 0);
+    std::copy(header + 64, header + 80, tail);
+    tail[16] = 0x80;
+    store_be64(tail + 56, 80 * 8);
+}
+
+void Sha256dHeader::hash(uint32_t nonce, Digest& out) const {
+    uint8_t block[64];
+    std::copy(tail, tail + 64, block);
+    // nonce is the last header field, stored little-endian
+    block[12] = static_cast<uint8_t>(nonce);
+    block[13] = static_cast<uint8_t>(nonce >> 8);
+    block[14] = static_cast<uint8_t>(nonce >> 16);
+    block[15] = static_cast<uint8_t>(nonce >> 24);
+
+    std::array<uint32_t, 8> state = midstate;
+    compress_blocks(state, block, 1);
+
+    Digest first;
+    for (int i = 0; i < 8; i++) {
+        store_be32(first.data() + i * 4, state[i]);
+    }
+    sha256_of_digest(first, out);
+}
+
+// ============ File Hashing ============
+// Regular files are mapped a window at a time and fed straight to the
+// kernel, so no copy is made and resident memory stays at one window.
+// Pipes and special files fall back to large read() chunks.
+
+#ifdef SHA256_POSIX_IO
+
+static const size_t kMapWindow = size_t(64) << 20;
+static const size_t kReadChunk = size_t(1) << 20;
+
+static bool hash_fd_read(int fd, Sha256Context& ctx) {
+    std::vector<uint8_t> chunk(kReadChunk);
+    for (;;) {
+        ssize_t n = ::read(fd, chunk.data(), chunk.size());
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        if (n == 0) return true;
+        ctx.update(chunk.data(), static_cast<size_t>(n));
+    }
+}
+
+static bool hash_fd_mmap(int fd, uint64_t size, Sha256Context& ctx) {
+    for (uint64_t offset = 0; offset < size; offset += kMapWindow) {
+        size_t len = static_cast<size_t>(std::min<uint64_t>(kMapWindow, size - offset));
+        void* map = ::mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, static_cast<off_t>(offset));
+        if (map == MAP_FAILED) {
+            return false;
+        }
+        ::madvise(map, len, MADV_SEQUENTIAL);
+        ctx.update(map, len);
+        ::munmap(map, len);
+    }
+    return true;
+}
+
+bool sha256_file(const std::string& path, Digest& digest) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    Sha256Context ctx;
+    struct stat st;
+    bool ok;
+    if (::fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+        ok = hash_fd_mmap(fd, static_cast<uint64_t>(st.st_size), ctx);
+        if (!ok) {
+            // e.g. a filesystem without mmap support: start over with read()
+            ctx.reset();
+            ok = ::lseek(fd, 0, SEEK_SET) == 0 && hash_fd_read(fd, ctx);
         }
     } else {
-        // Test with "abc" which should produce:
-        // ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad
-        std::cout << "SHA-256 of \"abc\": " << sha256("abc") << std::endl;
+        ok = hash_fd_read(fd, ctx);
     }
-    
-    return 0;
+    ::close(fd);
+
+    if (ok) {
+        ctx.final(digest);
+    }
+    return ok;
+}
+
+#else
+
+bool sha256_file(const std::string& path, Digest& digest) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    std::vector<char> chunk(1 << 20);
+    Sha256Context ctx;
+    while (file.read(chunk.data(), chunk.size()) || file.gcount() > 0) {
+        ctx.update(chunk.data(), static_cast<size_t>(file.gcount()));
+    }
+    if (file.bad()) {
+        return false;
+    }
+    ctx.final(digest);
+    return true;
 }
+
+#endif
@@ -4,6 +4,7 @@
 #include <iostream>
 #include <string>
 #include <vector>
+#include <array>
 #include <bitset>
 #include <cstdint>
 #include <cmath>
@@ -11,6 +12,7 @@
 #include <iomanip>
 #include <thread>
 #include <chrono>
+#include <functional>
 
 // ============ Global Variables ============
 extern std::string g_delay;
@@ -20,7 +22,9 @@ void clearScreen();
 std::string bits(uint32_t x, int n = 32);
 std::string hex(uint32_t i);
 std::string bitstring(const std::string& str);
-void delay(const std::string& speed);
+void delay(const std::string& speed);   // fastest..slowest, end, or ms
+void delay(int ms);                      // a pause within a step
+void waitForEnter();                     // end of a step in "enter" mode
 std::string input_type(const std::string& input);
 std::vector<uint8_t> bytes(const std::string& input, const std::string& type);
 
@@ -43,21 +47,539 @@ uint32_t maj(uint32_t x, uint32_t y, uint32_t z);
 
 // ============ Preprocessing ============
 std::string padding(const std::string& message);
+// 64-byte blocks after padding a message of `length` bytes: the 0x80
+// marker and the 64-bit length need 9 bytes after the data
+uint64_t padded_blocks(uint64_t length);
 std::vector<std::string> split(const std::string& message, int size = 512);
 
 // ============ Message Schedule ============
 std::vector<uint32_t> calculate_schedule(const std::string& block);
+std::vector<uint32_t> calculate_schedule(const uint8_t* block);
 
 // ============ Constants ============
-extern const std::vector<uint32_t> K;
-extern const std::vector<uint32_t> IV;
+#include "sha256_constants.h"
 
 // ============ Compression ============
 std::vector<uint32_t> compression(const std::vector<uint32_t>& initial, 
                                   const std::vector<uint32_t>& schedule,
                                   const std::vector<uint32_t>& constants);
+void compress(std::array<uint32_t, 8>& state, const uint8_t* block);
+
+// ============ Backends ============
+// compress_blocks() runs on the fastest backend the CPU supports (checked
+// once via CPUID). Set SHA256_BACKEND=scalar in the environment, or call
+// sha256_set_backend(), to force the portable kernel for cross-checking.
+enum class Sha256Backend { Scalar, ShaNi };
+
+bool sha256_backend_supported(Sha256Backend backend);
+bool sha256_set_backend(Sha256Backend backend);
+Sha256Backend sha256_get_backend();
+const char* sha256_backend_name(Sha256Backend backend);
+
+void compress_blocks(std::array<uint32_t, 8>& state, const uint8_t* data, size_t blocks);
+void compress_blocks_scalar(std::array<uint32_t, 8>& state, const uint8_t* data, size_t blocks);
+
+// sha256_shani.cpp (x86 SHA extensions)
+bool shani_supported();
+void compress_shani(std::array<uint32_t, 8>& state, const uint8_t* data, size_t blocks);
+
+// ============ Digest ============
+// Raw 32-byte SHA-256 output (the eight state words, big-endian).
+// std::array already compares with memcmp; DigestHash lets it key an
+// unordered container, e.g. std::unordered_set<Digest, DigestHash>.
+using Digest = std::array<uint8_t, 32>;
+
+struct DigestHash {
+    size_t operator()(const Digest& digest) const;
+};
+
+// 64 lowercase hex characters; the char* form writes into the caller's
+// buffer (no terminator) and never allocates
+void to_hex(const Digest& digest, char* out);
+std::string to_hex(const Digest& digest);
+
+// ============ Streaming Context ============
+// Incremental hashing: feed data with update() as it arrives, then call
+// final() once for the hex digest. Only the 8-word chaining state and one
+// partial 64-byte block are kept, so memory use is constant.
+class Sha256Context {
+public:
+    Sha256Context();
+    // Resume from a chaining state reached after `length` bytes (a
+    // multiple of 64), e.g. a precomputed keyed or header midstate
+    Sha256Context(const std::array<uint32_t, 8>& state, uint64_t length);
+
+    void reset();
+    void update(const void* data, size_t size);
+    void final(Digest& digest);
+    std::string final();
+
+    // Export/import the full hashing state so another process can carry
+    // on where this one stopped. Versioned binary layout:
+    //   "S256" | version (1) | 8 state words (BE) | length (8, BE) |
+    //   buffered count (1) | buffered bytes (0..63)
+    // load() rejects anything malformed and leaves the context untouched.
+    static const size_t kSavedMax = 4 + 1 + 32 + 8 + 1 + 63;
+    size_t save(uint8_t* out) const;   // writes up to kSavedMax bytes
+    std::vector<uint8_t> save() const;
+    bool load(const uint8_t* data, size_t size);
+
+private:
+    std::array<uint32_t, 8> hash;
+    uint8_t buffer[64];
+    size_t buffered;   // bytes waiting in buffer
+    uint64_t length;   // total message length in bytes
+};
 
 // ============ SHA-256 ============
+std::string sha256(const uint8_t* data, size_t length);
 std::string sha256(const std::string& str);
+Digest sha256_digest(const uint8_t* data, size_t length);
+Digest sha256_digest(const std::string& str);
+
+// ============ Double SHA-256 ============
+// sha256d(x) = SHA-256(SHA-256(x)), Bitcoin's Hash256. The second pass
+// hashes the 32 raw digest bytes as a single fixed-padding block.
+Digest sha256d(const uint8_t* data, size_t length);
+
+// An 80-byte block header hashed for many nonces. The first 64 bytes
+// are compressed once into a midstate, so each hash() only costs the
+// second header block plus the outer hash.
+class Sha256dHeader {
+public:
+    explicit Sha256dHeader(const uint8_t* header);   // 80 bytes
+
+    // nonce replaces header bytes 76..79 (little-endian)
+    void hash(uint32_t nonce, Digest& out) const;
+
+private:
+    friend void sha256d_header_batch(const Sha256dHeader& header, uint32_t first_nonce,
+                                     Digest* out, size_t count);
+
+    std::array<uint32_t, 8> midstate;
+    uint8_t tail[64];   // padded second block, nonce patched per call
+};
+
+// Hashes a file without loading it into memory: regular files are
+// mmap()ed in windows, pipes and devices are read in 1 MB chunks.
+// Returns false if the file cannot be opened or read.
+bool sha256_file(const std::string& path, Digest& digest);
+
+// ============ Batch Hashing ============
+// sha256_batch.cpp: hashes many independent messages at once, one per SIMD
+// lane (4 with SSE2, 8 with AVX2, 16 with AVX-512). Messages are grouped by
+// padded block count so lanes stay busy. SHA256_LANES=1/4/8/16 in the
+// environment caps the width (1 hashes each message on its own).
+struct ByteView {
+    const uint8_t* data;
+    size_t size;
+};
+
+void sha256_batch(const ByteView* in, Digest* out, size_t count);
+size_t sha256_batch_lanes();
+
+// Same, but every message continues from `state`, reached after `prefix`
+// bytes (a multiple of 64) that were already compressed
+void sha256_batch_from(const std::array<uint32_t, 8>& state, uint64_t prefix,
+                       const ByteView* in, Digest* out, size_t count);
+
+// Sha256dHeader::hash() for nonces first_nonce .. first_nonce + count - 1,
+// one nonce per lane
+void sha256d_header_batch(const Sha256dHeader& header, uint32_t first_nonce,
+                          Digest* out, size_t count);
+
+// ============ HMAC ============
+// sha256_hmac.cpp: HMAC-SHA256 (RFC 2104). The key is absorbed once: the
+// states after the 64-byte key^ipad and key^opad blocks are kept, so each
+// MAC costs the message blocks plus two finalization blocks.
+class HmacSha256 {
+public:
+    HmacSha256(const uint8_t* key, size_t key_length);
+    explicit HmacSha256(const std::string& key);
+
+    void mac(const uint8_t* data, size_t length, Digest& out) const;
+    Digest mac(const std::string& message) const;
+
+    // MACs of many messages under this key, one message per SIMD lane
+    void mac_batch(const ByteView* in, Digest* out, size_t count) const;
+
+    // Constant-time comparison against an expected tag
+    bool verify(const uint8_t* data, size_t length, const Digest& expected) const;
+
+    // Chaining states after the keyed blocks (64 bytes compressed)
+    const std::array<uint32_t, 8>& inner_state() const { return inner; }
+    const std::array<uint32_t, 8>& outer_state() const { return outer; }
+
+private:
+    std::array<uint32_t, 8> inner;   // after key ^ ipad
+    std::array<uint32_t, 8> outer;   // after key ^ opad
+};
+
+bool digest_equal_ct(const Digest& a, const Digest& b);
+
+// ============ HKDF ============
+// sha256_hkdf.cpp: HKDF-SHA256 (RFC 5869). HkdfSha256 holds the PRK's
+// keyed HMAC states, so every expand() (one per subkey/info) costs two
+// compressions per 32 output bytes plus the info blocks, writes straight
+// into `out` and never allocates. expand() fails past 255 * 32 bytes.
+void hkdf_sha256_extract(const uint8_t* salt, size_t salt_length,
+                         const uint8_t* ikm, size_t ikm_length, Digest& prk);
+
+class HkdfSha256 {
+public:
+    explicit HkdfSha256(const Digest& prk);
+    HkdfSha256(const uint8_t* salt, size_t salt_length,
+               const uint8_t* ikm, size_t ikm_length);   // extract + keep PRK
+
+    bool expand(const uint8_t* info, size_t info_length,
+                uint8_t* out, size_t out_length) const;
+
+private:
+    static Digest extract(const uint8_t* salt, size_t salt_length,
+                          const uint8_t* ikm, size_t ikm_length);
+
+    HmacSha256 hmac;   // keyed with the PRK
+};
+
+// Extract and expand in one call
+bool hkdf_sha256(const uint8_t* salt, size_t salt_length,
+                 const uint8_t* ikm, size_t ikm_length,
+                 const uint8_t* info, size_t info_length,
+                 uint8_t* out, size_t out_length);
+
+// ============ PBKDF2 ============
+// sha256_pbkdf2.cpp: PBKDF2-HMAC-SHA256 (RFC 8018). Every output block of
+// every password is an independent job; jobs run side by side in SIMD
+// lanes, each iteration being two fixed-padding compressions. Both fail
+// on zero iterations.
+bool pbkdf2_sha256(const uint8_t* password, size_t password_length,
+                   const uint8_t* salt, size_t salt_length, uint32_t iterations,
+                   uint8_t* out, size_t out_length);
+
+// Same salt and iterations for every candidate; out holds
+// count * out_length bytes, candidate i at out + i * out_length
+bool pbkdf2_sha256_batch(const ByteView* passwords, size_t count,
+                         const uint8_t* salt, size_t salt_length, uint32_t iterations,
+                         uint8_t* out, size_t out_length);
+
+// sha256_batch.cpp: `rounds` times U = HMAC(U), T ^= U for each job, given
+// the keyed HMAC states; one job per lane
+void hmac_iterate_batch(const std::array<uint32_t, 8>* inner, const std::array<uint32_t, 8>* outer,
+                        Digest* u, Digest* t, size_t count, uint32_t rounds);
+
+// ============ Content-Defined Chunking ============
+// sha256_cdc.cpp: splits a stream into variable-size chunks at
+// content-defined boundaries (FastCDC-style Gear hash), so an insertion
+// only changes the chunks around it, and reports each chunk's SHA-256.
+// Chunking runs on the calling thread, hashing on `threads` workers (0: one
+// per core); records arrive in stream order, one emit() at a time.
+struct CdcParams {
+    size_t min_size = 2 * 1024;
+    size_t avg_size = 8 * 1024;    // power of two
+    size_t max_size = 64 * 1024;
+
+    // 0 < min <= avg <= max and avg a power of two, which the Gear masks
+    // are derived from
+    bool valid() const;
+};
+
+struct ChunkRecord {
+    uint64_t offset;
+    size_t length;
+    Digest digest;
+};
+
+class CdcChunker {
+public:
+    explicit CdcChunker(const CdcParams& params);   // params.valid() must hold
+
+    // Length of the chunk starting at data; `size` bytes are available
+    // and the chunk ends there if no boundary is found first
+    size_t cut(const uint8_t* data, size_t size) const;
+
+private:
+    CdcParams params;
+    uint64_t mask_small;   // before avg_size: harder to cut
+    uint64_t mask_large;   // after avg_size: easier to cut
+};
+
+// false on invalid params or a read error
+bool sha256_cdc(std::istream& in, const CdcParams& params, size_t threads,
+                const std::function<void(const ChunkRecord&)>& emit);
+bool sha256_cdc_file(const std::string& path, const CdcParams& params, size_t threads,
+                     const std::function<void(const ChunkRecord&)>& emit);
+
+// ============ Mining ============
+// sha256_mine.cpp: proof-of-work nonce search over an 80-byte header on
+// `threads` workers (0: one per core). Stops at the first nonce whose
+// Hash256, read as a little-endian number, is <= target (big-endian
+// bytes), or after max_nonces tries.
+struct MineResult {
+    bool found;
+    uint32_t nonce;
+    Digest hash;
+    uint64_t hashes;   // nonces tried, across all threads
+    double seconds;
+};
+
+MineResult sha256d_mine(const uint8_t* header, const Digest& target, size_t threads,
+                        uint32_t first_nonce = 0, uint64_t max_nonces = uint64_t(1) << 32);
+
+// Expands the compact nBits field of a header into a 256-bit target
+Digest target_from_bits(uint32_t bits);
+
+// ============ Merkle Trees ============
+// sha256_merkle.cpp: Bitcoin-style trees, parent = sha256d(left || right)
+// with the last node repeated on odd levels. Levels are hashed with
+// sha256_batch(); levels of 16K+ pairs are split across `threads`
+// (0: one per core). No leaves gives an all-zero root.
+Digest merkle_root(const Digest* leaves, size_t count, size_t threads = 0);
+
+// Keeps every level so inclusion proofs can be read off afterwards
+class MerkleTree {
+public:
+    MerkleTree(const Digest* leaves, size_t count, size_t threads = 0);
+
+    const Digest& root() const;
+
+    size_t leaves() const { return leaf_count; }
+
+    // Sibling hashes from the leaf up to (not including) the root; empty
+    // for an index past the last leaf (and for a one-leaf tree)
+    std::vector<Digest> proof(size_t index) const;
+
+private:
+    std::vector<std::vector<Digest>> levels;   // levels[0] = leaves
+    size_t leaf_count;
+};
+
+bool merkle_verify(const Digest& leaf, size_t index, const std::vector<Digest>& proof,
+                   const Digest& root);
+
+// ============ Tree Hashing ============
+// sha256_tree.cpp: an opt-in parallel digest for huge inputs. NOT the
+// SHA-256 of the data: fixed-size chunks are hashed on `threads` workers
+// (0: one per core) and combined in a binary tree, see sha256_tree.cpp
+// for the exact layout. Always label the result with sha256_tree_name().
+// A chunk size of 0 is rejected: both digests fail, the name is empty.
+const size_t kTreeChunkDefault = size_t(1) << 20;
+
+std::string sha256_tree_name(size_t chunk_size);   // e.g. "SHA256-TREE-1M"
+bool sha256_tree(const uint8_t* data, size_t length, size_t chunk_size, size_t threads,
+                 Digest& digest);
+bool sha256_tree_file(const std::string& path, size_t chunk_size, size_t threads, Digest& digest);
+
+// ============ Trace Recording ============
+// sha256_trace.cpp: runs the whole computation up front, with no display
+// or delays, and keeps what every compression did so the animations can
+// replay it and jump straight to any block and round. Per block only the
+// chaining state going in, the 64 schedule words and the new a and e of
+// each round are stored (800 bytes): b..d and f..h are earlier a and e
+// values, and T1/T2 follow from them. A long message can keep just a
+// window of blocks; every block still gets its count of a..h bits
+// flipped (4 bytes), which is all the overview map needs.
+
+// The working variables after one round, and the T1/T2 that produced them
+struct TraceRound {
+    std::array<uint32_t, 8> reg;   // a..h
+    uint32_t t1;
+    uint32_t t2;
+};
+
+class Sha256Trace {
+public:
+    void record(const uint8_t* data, size_t length);
+    void record(const std::string& str);
+    // Keeps blocks [first, first + count) only; the rest are compressed
+    // and dropped. Only kept blocks may be read back below.
+    void record(const uint8_t* data, size_t length, size_t first, size_t count);
+
+    size_t blocks() const { return flips.size(); }
+    uint64_t message_length() const { return length; }
+    uint32_t flipped(size_t block) const { return flips[block]; }   // any block
+    const std::array<uint32_t, 8>& final_state() const { return final; }
+
+    const std::array<uint32_t, 8>& state_before(size_t block) const;
+    std::array<uint32_t, 8> state_after(size_t block) const;
+    const uint32_t* schedule(size_t block) const;   // W0..W63
+    TraceRound round(size_t block, int round) const;   // round 0..63
+    Digest digest() const;
+    std::vector<uint8_t> message() const;   // from W0..W15, all blocks kept
+
+    // Binary form of a trace with all blocks kept: "S25T" | version (1) | message length (8, BE) |
+    // block count (4, BE) | per block: state, W0..W63, a0..a63, e0..e63
+    // (200 words, BE). load() re-records the message held in W0..W15 and
+    // rejects the trace unless every stored word matches.
+    std::vector<uint8_t> save() const;
+    bool load(const uint8_t* data, size_t size);
+
+private:
+    struct Block {
+        std::array<uint32_t, 8> initial;
+        uint32_t w[64];
+        uint32_t a[64];
+        uint32_t e[64];
+    };
+
+    std::vector<Block> steps;       // the kept blocks
+    size_t first = 0;               // block number of steps[0]
+    std::vector<uint32_t> flips;    // a..h bits flipped, per block
+    std::array<uint32_t, 8> final{};
+    uint64_t length = 0;
+};
+
+// ============ Frame Renderer ============
+// sha256_frame.cpp: once attach()ed, std::cout is composed into an
+// in-memory frame instead of going to the terminal line by line.
+// clearScreen() starts the next frame and delay() presents the current
+// one, so the animations need no other changes. present() diffs the frame
+// against what is on screen and sends only the changed cells (colour
+// codes and UTF-8 included) in a single write(). When stdout is not a
+// terminal the frame is passed through unchanged.
+class FrameRenderer {
+public:
+    explicit FrameRenderer(int fd = 1);
+    ~FrameRenderer();   // presents the last frame and detaches
+
+    void attach();
+    void detach();
+    bool attached() const { return saved != nullptr; }
+
+    void begin();        // drop the frame being composed, start an empty one
+    void present();      // may be called repeatedly while a frame grows
+    void invalidate();   // redraw everything on the next present()
+
+    // The text composed so far, and a way to put an earlier frame back on
+    // screen (terminal only), for the playback clock's rewind
+    std::string frame() const { return back.str(); }
+    void show(const std::string& text);
+
+    // Bytes sent to the terminal by the last present()
+    size_t last_write() const { return written; }
+
+    // Terminal columns and rows, 80x24 when not a terminal
+    void size(int& width, int& height) const;
+
+private:
+    struct Cell {
+        std::string glyph;   // one UTF-8 character
+        std::string style;   // SGR sequences in effect, "" = default
+        bool operator==(const Cell& other) const {
+            return glyph == other.glyph && style == other.style;
+        }
+    };
+    typedef std::vector<std::vector<Cell>> Grid;
+
+    void layout(const std::string& text, int width, Grid& grid) const;
+    void draw(const std::string& text);
+    void write_all(const std::string& data);
+
+    int fd;
+    bool tty;
+    bool dirty;           // screen contents unknown, full redraw needed
+    std::stringbuf back;  // frame being composed
+    std::streambuf* saved;
+    size_t sent;          // bytes of back already passed through (no terminal)
+    Grid front;           // what the terminal shows
+    size_t written;
+    int drawn_width;      // terminal size front was laid out for
+    int drawn_height;
+};
+
+// The renderer on stdout used by clearScreen() and delay()
+FrameRenderer& frame_renderer();
+
+// ============ Playback Clock ============
+// sha256_playback.cpp: paces the animations. delay() hands every frame to
+// the clock, which waits for a deadline on the monotonic clock while
+// polling the keyboard (raw mode, nothing blocks):
+//   space      pause / resume          n, Enter, right  step one frame
+//   b, left    back one frame          + / -            faster / slower
+//   q          quit
+// Frames stepped back to are redrawn from the frame renderer's history;
+// playing or stepping on from there catches up with the live animation.
+// g_delay picks the starting mode: "enter" starts paused, "fast" at
+// double speed, "nodelay" never waits. When stdin is not a terminal the
+// clock just sleeps, and "enter" reads a line as before.
+class PlaybackClock {
+public:
+    PlaybackClock();
+    ~PlaybackClock();
+
+    void wait(int ms);                     // hold the current frame ms / speed()
+    void wait(const std::string& speed);   // fastest..slowest, end, or ms
+
+    double speed() const { return base * multiplier; }
+    void set_speed(double speed);
+    bool paused() const { return pause; }
+
+    static const size_t kHistory = 1024;   // frames kept for rewinding
+
+private:
+    enum class Mode { Timed, Step, NoDelay };
+
+    void sync_mode();
+    bool raw_input(bool on);
+    int read_key(int timeout_ms);
+    bool handle(int key, std::chrono::steady_clock::time_point& deadline,
+                std::chrono::steady_clock::duration frame);
+
+    Mode mode;
+    std::string mode_source;   // g_delay value mode was taken from
+    double base;               // from g_delay: 2 for "fast"
+    double multiplier;         // chosen with +/- or set_speed()
+    bool pause;
+    bool interactive;          // stdin is a terminal
+    std::chrono::steady_clock::time_point last_deadline;
+    std::vector<std::string> history;   // ring of presented frames
+    size_t newest;             // frames recorded so far
+    size_t shown;              // frame on screen, == newest when live
+};
+
+PlaybackClock& playback_clock();
+
+// ============ Level-of-Detail Views ============
+// sha256_overview.cpp: views of a recorded trace for messages too long to
+// print bit by bit, sized by the screen rather than the input. Each block
+// is reduced to one number, the bits of a..h its 64 rounds flipped; a map
+// draws one shaded cell per run of blocks, and only the selected block is
+// expanded round by round.
+
+// True when the padded message of `length` bytes has more bits than the
+// terminal has cells
+bool overview_needed(uint64_t length);
+
+// `text` cut to at most `width` characters, its middle replaced by
+// "...[N more]..."; ASCII text only
+std::string elide(const std::string& text, size_t width);
+
+// The same for a text of `total` characters too long to build: `head`
+// and `tail` are its first and last `width` (or more) characters
+std::string elide(const std::string& head, const std::string& tail, uint64_t total, size_t width);
+
+// Bits [first, first + count) of the padded message (the data, a 1,
+// zeros and the 64-bit length) as '0'/'1' text, without building the rest
+std::string padded_bits(const uint8_t* data, uint64_t length, uint64_t first, uint64_t count);
+
+class TraceOverview {
+public:
+    // Keeps a reference; round_map() needs the block kept in the trace
+    explicit TraceOverview(const Sha256Trace& trace);
+
+    size_t blocks() const { return trace.blocks(); }
+    uint32_t block_flips(size_t block) const { return trace.flipped(block); }
+
+    // At most `rows` lines of `width` cells plus a legend line; every cell
+    // shows the busiest block of its run, the one holding `selected` in
+    // reverse video
+    std::string block_map(size_t width, size_t rows, size_t selected) const;
+
+    // Lines a..h by rounds 0..63 of `block`: the bits each round flipped
+    std::string round_map(size_t block) const;
+
+private:
+    const Sha256Trace& trace;
+    uint32_t low, high;            // range of flips, for shading
+};
 
 #endif // SHA256LIB_H
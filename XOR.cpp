@@ -8,31 +8,19 @@
 #include <cmath>
 #include <sstream>
 
-void clearScreen(){
-	std::cout << "\033[2J\033[1;1H";
-}
-void sleep(double seconds){
-	std::this_thread::sleep_for(std::chrono::milliseconds(static_cast<int>(seconds*1000)));
-}
+#include "SHA.h"
 
 std::string toBinaryString(uint32_t value){
 	return std::bitset<32>(value).to_string();
 }
 
-uint32_t rotr(int n, uint32_t x) {
-    uint32_t mask = 0xFFFFFFFF;
-    uint32_t right = (x >> n) & mask;
-    uint32_t left = (x << (32 - n)) & mask;
-    return right | left;
-}
-
 
 
 void showXORAnimation() {
     uint32_t off = 0b00000000000000000000000000000000;
     uint32_t on = 0b11111111111111111111111111111111;
     uint32_t split = 0b10101010101010101010101010101010;
-    double delay = 0.4;
+    int step = 400;   // ms
 
     // Up To All 1
     clearScreen();
@@ -41,7 +29,7 @@ void showXORAnimation() {
     std::cout << toBinaryString(off) << " XOR" << std::endl;
     std::cout << "--------------------------------" << std::endl;
     std::cout << toBinaryString(off ^ off ^ off) << std::endl;
-    sleep(delay);
+    delay(step);
 
     clearScreen();
     std::cout << toBinaryString(on) << std::endl;
@@ -49,7 +37,7 @@ void showXORAnimation() {
     std::cout << toBinaryString(off) << " XOR" << std::endl;
     std::cout << "--------------------------------" << std::endl;
     std::cout << toBinaryString(on ^ off ^ off) << std::endl;
-    sleep(delay);
+    delay(step);
 
     clearScreen();
     std::cout << toBinaryString(on) << std::endl;
@@ -57,7 +45,7 @@ void showXORAnimation() {
     std::cout << toBinaryString(off) << " XOR" << std::endl;
     std::cout << "--------------------------------" << std::endl;
     std::cout << toBinaryString(on ^ on ^ off) << std::endl;
-    sleep(delay);
+    delay(step);
 
     clearScreen();
     std::cout << toBinaryString(on) << std::endl;
@@ -65,7 +53,7 @@ void showXORAnimation() {
     std::cout << toBinaryString(on) << " XOR" << std::endl;
     std::cout << "--------------------------------" << std::endl;
     std::cout << toBinaryString(on ^ on ^ on) << std::endl;
-    sleep(delay);
+    delay(step);
 
     // Back To All 0
     clearScreen();
@@ -74,7 +62,7 @@ void showXORAnimation() {
     std::cout << toBinaryString(on) << " XOR" << std::endl;
     std::cout << "--------------------------------" << std::endl;
     std::cout << toBinaryString(off ^ on ^ on) << std::endl;
-    sleep(delay);
+    delay(step);
 
     clearScreen();
     std::cout << toBinaryString(off) << std::endl;
@@ -82,7 +70,7 @@ void showXORAnimation() {
     std::cout << toBinaryString(on) << " XOR" << std::endl;
     std::cout << "--------------------------------" << std::endl;
     std::cout << toBinaryString(off ^ off ^ on) << std::endl;
-    sleep(delay);
+    delay(step);
 
     clearScreen();
     std::cout << toBinaryString(off) << std::endl;
@@ -90,7 +78,7 @@ void showXORAnimation() {
     std::cout << toBinaryString(off) << " XOR" << std::endl;
     std::cout << "--------------------------------" << std::endl;
     std::cout << toBinaryString(off ^ off ^ off) << std::endl;
-    sleep(delay);
+    delay(step);
 
     // Only One 1
     clearScreen();
@@ -99,7 +87,7 @@ void showXORAnimation() {
     std::cout << toBinaryString(off) << " XOR" << std::endl;
     std::cout << "--------------------------------" << std::endl;
     std::cout << toBinaryString(on ^ off ^ off) << std::endl;
-    sleep(delay);
+    delay(step);
 
     clearScreen();
     std::cout << toBinaryString(off) << std::endl;
@@ -107,7 +95,7 @@ void showXORAnimation() {
     std::cout << toBinaryString(off) << " XOR" << std::endl;
     std::cout << "--------------------------------" << std::endl;
     std::cout << toBinaryString(off ^ on ^ off) << std::endl;
-    sleep(delay);
+    delay(step);
 
     clearScreen();
     std::cout << toBinaryString(off) << std::endl;
@@ -115,7 +103,7 @@ void showXORAnimation() {
     std::cout << toBinaryString(on) << " XOR" << std::endl;
     std::cout << "--------------------------------" << std::endl;
     std::cout << toBinaryString(off ^ off ^ on) << std::endl;
-    sleep(delay);
+    delay(step);
 
     // Majority 1
     clearScreen();
@@ -124,7 +112,7 @@ void showXORAnimation() {
     std::cout << toBinaryString(on) << " XOR" << std::endl;
     std::cout << "--------------------------------" << std::endl;
     std::cout << toBinaryString(off ^ on ^ on) << std::endl;
-    sleep(delay);
+    delay(step);
 
     clearScreen();
     std::cout << toBinaryString(on) << std::endl;
@@ -132,7 +120,7 @@ void showXORAnimation() {
     std::cout << toBinaryString(on) << " XOR" << std::endl;
     std::cout << "--------------------------------" << std::endl;
     std::cout << toBinaryString(on ^ off ^ on) << std::endl;
-    sleep(delay);
+    delay(step);
 
     clearScreen();
     std::cout << toBinaryString(on) << std::endl;
@@ -140,7 +128,7 @@ void showXORAnimation() {
     std::cout << toBinaryString(off) << " XOR" << std::endl;
     std::cout << "--------------------------------" << std::endl;
     std::cout << toBinaryString(on ^ on ^ off) << std::endl;
-    sleep(delay);
+    delay(step);
 
     // All 1
     clearScreen();
@@ -149,8 +137,8 @@ void showXORAnimation() {
     std::cout << toBinaryString(on) << " XOR" << std::endl;
     std::cout << "--------------------------------" << std::endl;
     std::cout << toBinaryString(on ^ on ^ on) << std::endl;
-    sleep(delay);
-    sleep(delay);
+    delay(step);
+    delay(step);
 
     // Split
     clearScreen();
@@ -159,7 +147,7 @@ void showXORAnimation() {
     std::cout << toBinaryString(split) << " XOR" << std::endl;
     std::cout << "--------------------------------" << std::endl;
     std::cout << toBinaryString(on ^ on ^ split) << std::endl;
-    sleep(delay);
+    delay(step);
 
     // Split - Rotate
     for (int i = 1; i <= 9; i++) {
@@ -169,9 +157,9 @@ void showXORAnimation() {
         std::cout << toBinaryString(rotr(i, split)) << " XOR" << std::endl;
         std::cout << "--------------------------------" << std::endl;
         std::cout << toBinaryString(on ^ on ^ rotr(i, split)) << std::endl;
-        sleep(delay / 2);
+        delay(step / 2);
     }
-    sleep(delay);
+    delay(step);
 
     for (int i = 1; i <= 9; i++) {
         clearScreen();
@@ -180,9 +168,9 @@ void showXORAnimation() {
         std::cout << toBinaryString(rotr(i, split)) << " XOR" << std::endl;
         std::cout << "--------------------------------" << std::endl;
         std::cout << toBinaryString(on ^ off ^ rotr(i, split)) << std::endl;
-        sleep(delay / 2);
+        delay(step / 2);
     }
-    sleep(delay);
+    delay(step);
 
     for (int i = 1; i <= 9; i++) {
         clearScreen();
@@ -191,9 +179,9 @@ void showXORAnimation() {
         std::cout << toBinaryString(rotr(i, split)) << " XOR" << std::endl;
         std::cout << "--------------------------------" << std::endl;
         std::cout << toBinaryString(off ^ off ^ rotr(i, split)) << std::endl;
-        sleep(delay / 2);
+        delay(step / 2);
     }
-    sleep(delay);
+    delay(step);
 }
 
 // ============ Command Line XOR Calculator ============
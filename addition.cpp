@@ -7,6 +7,7 @@
 #include <thread>
 #include <chrono>
 
+#include "SHA.h"
 
 using namespace std;
 
@@ -28,38 +29,41 @@ int main(int argc, char* argv[]) {
 		}
 	}
 
-	uint64_t total = accumulate(numbers.begin(), numbers.end, uint64_t(0));
-	size_t width = bitset<64>(total).to_string().find('1');
-	width = 64 - width;
+	uint64_t total = accumulate(numbers.begin(), numbers.end(), uint64_t(0));
+	size_t width = 64 - bitset<64>(total).to_string().find('1');
+	if (width < 32) width = 32;
 
-	for (size_t j=0; j<number.size(); j++){
-		string bin= bitset<32>(numbers[j]).to_string();
-		cout << string(width - bin.size(), '  ') << bin;
-		if(j > 0 && j<= i){
-			cout << "+";
+	// one frame per partial sum, then the final sum reduced mod 2**32
+	for (size_t i = 0; i <= numbers.size(); i++) {
+		clearScreen();
+
+		for (size_t j = 0; j < numbers.size(); j++) {
+			string bin = bitset<32>(numbers[j]).to_string();
+			cout << string(width - bin.size(), ' ') << bin;
+			if (j > 0 && j <= i) {
+				cout << " +";
+			}
+			cout << "\n";
 		}
-		cout << "\n";
-	}
 
-	cout << string (width - 32, '  ') <<
+		cout << string(width, '-') << "\n";
 
-	if (i == 0) {
-            cout << "\n";
-        } else if (i < numbers.size()) {
-            uint64_t sum = accumulate(numbers.begin(), numbers.begin() + i + 1, uint64_t(0));
-            cout << string(width - 32, ' ') << bitset<32>(sum).to_string() << "\n";
-            if (i == numbers.size() - 1)
-                this_thread::sleep_for(chrono::milliseconds(400));
-        } else {
-            uint64_t sum = accumulate(numbers.begin(), numbers.end(), uint64_t(0));
-            uint32_t modSum = sum % (1ULL << 32);
-            cout << string(width - 32, ' ') << bitset<32>(modSum).to_string() << " mod 2**32\n";
-        }
+		if (i == 0) {
+			cout << "\n";
+		} else if (i < numbers.size()) {
+			uint64_t sum = accumulate(numbers.begin(), numbers.begin() + i + 1, uint64_t(0));
+			string bin = bitset<64>(sum).to_string().substr(64 - width);
+			cout << bin << "\n";
+			if (i == numbers.size() - 1)
+				delay(400);
+		} else {
+			uint32_t modSum = static_cast<uint32_t>(total % (1ULL << 32));
+			cout << string(width - 32, ' ') << bitset<32>(modSum).to_string() << " mod 2**32\n";
+		}
 
-        this_thread::sleep_for(chrono::milliseconds(400));
-    }
+		delay(400);
+	}
 
-    this_thread::sleep_for(chrono::seconds(1));
-    return 0;
+	delay(1000);
+	return 0;
 }
-
@@ -5,47 +5,12 @@
 #include <string>
 #include <thread>
 #include <chrono>
+
+#include "SHA.h"
 #include <cstdlib>
 
 using namespace std;
 
-string bits(uint32_t v) {
-    string s;
-    for (int i = 31; i >= 0; --i) s.push_back((v & (1u << i)) ? '1' : '0');
-    return s;
-}
-
-uint32_t rotr(uint32_t x, int n) {
-    return (x >> n) | (x << (32 - n));
-}
-
-uint32_t usigma0(uint32_t x) {
-    return rotr(x,2) ^ rotr(x,13) ^ rotr(x,22);
-}
-
-uint32_t usigma1(uint32_t x) {
-    return rotr(x,6) ^ rotr(x,11) ^ rotr(x,25);
-}
-
-uint32_t ch(uint32_t x, uint32_t y, uint32_t z) {
-    return (x & y) ^ (~x & z);
-}
-
-uint32_t maj(uint32_t x, uint32_t y, uint32_t z) {
-    return (x & y) ^ (x & z) ^ (y & z);
-}
-
-uint32_t add(uint32_t a, uint32_t b) { return (a + b) % (1u<<32); }
-uint32_t add(uint32_t a, uint32_t b, uint32_t c, uint32_t d, uint32_t e) { return (a + b + c + d + e) % (1u<<32); }
-
-void delay(string level) {
-    if (level=="normal") this_thread::sleep_for(chrono::milliseconds(400));
-    else if (level=="slow") this_thread::sleep_for(chrono::seconds(1));
-    else if (level=="slowest") this_thread::sleep_for(chrono::seconds(2));
-    else if (level=="fastest") this_thread::sleep_for(chrono::milliseconds(100));
-    else if (level=="end") this_thread::sleep_for(chrono::seconds(3));
-}
-
 int main() {
     // --------- Constants K ---------
     vector<int> primes = {2,3,5,7,11,13,17,19,23,29,31,37,41,43,47,53,
@@ -1 +1 @@
-g++ -Wall -O2 -std=c++17 *.cpp -o sha_program
+make -j"$(nproc)"
@@ -5,37 +5,12 @@
 #include <thread>
 #include <chrono>
 
-// --- Utility functions ---
-std::string bits(uint32_t x) {
-    return std::bitset<32>(x).to_string();
-}
-
-uint32_t rotr(int n, uint32_t x) {
-    return (x >> n) | (x << (32 - n));
-}
-
-uint32_t shr(int n, uint32_t x) {
-    return x >> n;
-}
+#include "SHA.h"
 
 void clear_screen() {
     system("clear"); // Linux terminal clear
 }
 
-void sleep_ms(int ms) {
-    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
-}
-
-// --- σ0(x) ---
-uint32_t sigma0(uint32_t x) {
-    return rotr(7, x) ^ rotr(18, x) ^ shr(3, x);
-}
-
-// --- σ1(x) ---
-uint32_t sigma1(uint32_t x) {
-    return rotr(17, x) ^ rotr(19, x) ^ shr(10, x);
-}
-
 // --- Main driver ---
 int main(int argc, char* argv[]) {
     uint32_t x = 0b00000000000000000011111111111111; // default
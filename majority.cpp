@@ -6,20 +6,9 @@
 #include <cstdint>
 #include <map>
 
-// ============ Utility Functions ============
-
-void clearScreen() {
-    std::cout << "\033[2J\033[1;1H";
-}
+#include "SHA.h"
 
-std::string bits(uint32_t x) {
-    return std::bitset<32>(x).to_string();
-}
-
-// Majority function: (x & y) ^ (x & z) ^ (y & z)
-uint32_t maj(uint32_t x, uint32_t y, uint32_t z) {
-    return (x & y) ^ (x & z) ^ (y & z);
-}
+// ============ Utility Functions ============
 
 // Calculate majority of three bits
 char maj_bit(char x, char y, char z) {
@@ -94,7 +83,7 @@ int main(int argc, char* argv[]) {
                   << " >= 2)" << std::endl;
         
         // Delay
-        std::this_thread::sleep_for(std::chrono::milliseconds(300));
+        delay(300);
     }
     
     // Final result
@@ -111,7 +100,7 @@ int main(int argc, char* argv[]) {
     std::cout << "Hex: 0x" << std::hex << result << std::dec << std::endl;
     std::cout << "========================" << std::endl;
     
-    std::this_thread::sleep_for(std::chrono::seconds(2));
+    delay(2000);
     
     return 0;
 }
@@ -8,70 +8,32 @@
 #include <chrono>
 #include <cmath>
 #include <cstdint>
+#include <array>
+#include <algorithm>
 #include <fstream>
+#include <cstdlib>
+
+#include "SHA.h"
 
 // ============ Global Variables ============
 std::string g_input = "abc";
 std::string g_type = "string";
 std::vector<uint8_t> g_bytes;
-std::string g_message;
-std::string g_padded;
+Sha256Trace g_trace;
 size_t g_l;                    // length of message in bits
 int g_k;                       // number of zeros to pad
-std::vector<std::string> g_blocks;
-std::vector<uint32_t> g_hash;
+std::array<uint32_t, 8> g_hash;
 std::string g_digest;
 std::string g_state;
-std::string g_delay = "normal";
+bool g_overview = false;       // too long to show bit by bit
+size_t g_selected = 0;         // block expanded in the overview
 
 // ============ Utility Functions ============
 
-void clearScreen() {
-    std::cout << "\033[2J\033[1;1H";
-}
-
-void delay(const std::string& speed) {
-    if (g_delay == "enter") {
-        std::cin.get();
-    } else if (g_delay == "nodelay") {
-        std::this_thread::sleep_for(std::chrono::milliseconds(0));
-    } else {
-        double multiplier = 1.0;
-        if (g_delay == "fast") multiplier = 0.5;
-        
-        int sleepTime = 0;
-        if (speed == "fastest") sleepTime = 100 * multiplier;
-        else if (speed == "fast") sleepTime = 200 * multiplier;
-        else if (speed == "normal") sleepTime = 400 * multiplier;
-        else if (speed == "slow") sleepTime = 600 * multiplier;
-        else if (speed == "slowest") sleepTime = 800 * multiplier;
-        else if (speed == "end") sleepTime = 1000 * multiplier;
-        
-        std::this_thread::sleep_for(std::chrono::milliseconds(sleepTime));
-    }
-}
-
-void delayMilliseconds(int ms) {
-    if (g_delay != "nodelay" && g_delay != "enter") {
-        std::this_thread::sleep_for(std::chrono::milliseconds(ms));
-    }
-}
-
-std::string bits(uint32_t x, int n = 32) {
-    std::string binary = std::bitset<32>(x).to_string();
-    return binary.substr(32 - n, n);
-}
-
 std::string bits64(size_t x, int n = 64) {
     return std::bitset<64>(x).to_string().substr(64 - n, n);
 }
 
-std::string hex(uint32_t i) {
-    std::stringstream ss;
-    ss << std::hex << std::setfill('0') << std::setw(8) << i;
-    return ss.str();
-}
-
 std::string bytesToHex(const std::vector<uint8_t>& bytes) {
     std::stringstream ss;
     ss << std::hex << std::setfill('0');
@@ -83,8 +45,9 @@ std::string bytesToHex(const std::vector<uint8_t>& bytes) {
 
 std::string bytesToBinary(const std::vector<uint8_t>& bytes) {
     std::string result;
-    for (uint8_t byte : bytes) {
-        result += std::bitset<8>(byte).to_string();
+    for (size_t i = 0; i < bytes.size(); i++) {
+        result += std::bitset<8>(bytes[i]).to_string();
+        if (i < bytes.size() - 1) result += " ";
     }
     return result;
 }
@@ -100,178 +63,59 @@ std::string bytesInspect(const std::vector<uint8_t>& bytes) {
     return ss.str();
 }
 
-std::string stringToBinary(const std::string& str) {
-    std::string result;
-    for (unsigned char c : str) {
-        result += std::bitset<8>(c).to_string();
-    }
-    return result;
-}
-
-// ============ SHA-256 Operations ============
-
-uint32_t rotr(int n, uint32_t x) {
-    return (x >> n) | (x << (32 - n));
-}
-
-uint32_t shr(int n, uint32_t x) {
-    return x >> n;
+// In the overview a long value is cut to fit on the line after its label
+std::string fit(const std::string& text, size_t label) {
+    if (!g_overview) return text;
+    int width, height;
+    frame_renderer().size(width, height);
+    return elide(text, static_cast<size_t>(width) > label ? width - label : 1);
 }
 
-uint32_t sigma0(uint32_t x) {
-    return rotr(7, x) ^ rotr(18, x) ^ shr(3, x);
+// The same for the formatted message: the overview formats only the
+// bytes at either end; `total` is the length of the whole text
+std::string fitBytes(std::string (*format)(const std::vector<uint8_t>&), uint64_t total, size_t label) {
+    if (!g_overview) return format(g_bytes);
+    int width, height;
+    frame_renderer().size(width, height);
+    size_t ends = std::min(static_cast<size_t>(width), g_bytes.size());
+    std::string head = format(std::vector<uint8_t>(g_bytes.begin(), g_bytes.begin() + ends));
+    std::string tail = format(std::vector<uint8_t>(g_bytes.end() - ends, g_bytes.end()));
+    return elide(head, tail, total, static_cast<size_t>(width) > label ? width - label : 1);
 }
 
-uint32_t sigma1(uint32_t x) {
-    return rotr(17, x) ^ rotr(19, x) ^ shr(10, x);
-}
-
-uint32_t usigma0(uint32_t x) {
-    return rotr(2, x) ^ rotr(13, x) ^ rotr(22, x);
-}
-
-uint32_t usigma1(uint32_t x) {
-    return rotr(6, x) ^ rotr(11, x) ^ rotr(25, x);
-}
-
-uint32_t ch(uint32_t x, uint32_t y, uint32_t z) {
-    return (x & y) ^ ((~x) & z);
-}
-
-uint32_t maj(uint32_t x, uint32_t y, uint32_t z) {
-    return (x & y) ^ (x & z) ^ (y & z);
-}
-
-uint32_t add(uint32_t a, uint32_t b) {
-    return (a + b) & 0xFFFFFFFF;
-}
-
-uint32_t add(uint32_t a, uint32_t b, uint32_t c) {
-    return (a + b + c) & 0xFFFFFFFF;
-}
-
-uint32_t add(uint32_t a, uint32_t b, uint32_t c, uint32_t d) {
-    uint64_t total = static_cast<uint64_t>(a) + b + c + d;
-    return static_cast<uint32_t>(total & 0xFFFFFFFF);
-}
-
-uint32_t add(uint32_t a, uint32_t b, uint32_t c, uint32_t d, uint32_t e) {
-    uint64_t total = static_cast<uint64_t>(a) + b + c + d + e;
-    return static_cast<uint32_t>(total & 0xFFFFFFFF);
-}
-
-// ============ SHA-256 Constants ============
-
-std::vector<uint32_t> calculateK() {
-    std::vector<uint32_t> constants;
-    int primes[] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53, 
-                    59, 61, 67, 71, 73, 79, 83, 89, 97, 101, 103, 107, 109, 113, 
-                    127, 131, 137, 139, 149, 151, 157, 163, 167, 173, 179, 181, 
-                    191, 193, 197, 199, 211, 223, 227, 229, 233, 239, 241, 251, 
-                    257, 263, 269, 271, 277, 281, 283, 293, 307, 311};
-    
-    for (int prime : primes) {
-        double cubeRoot = std::pow(prime, 1.0 / 3.0);
-        double fractional = cubeRoot - std::floor(cubeRoot);
-        uint32_t value = static_cast<uint32_t>(fractional * std::pow(2, 32));
-        constants.push_back(value);
-    }
-    return constants;
-}
-
-std::vector<uint32_t> calculateIV() {
-    std::vector<uint32_t> initial;
-    int primes[] = {2, 3, 5, 7, 11, 13, 17, 19};
-    
-    for (int prime : primes) {
-        double squareRoot = std::sqrt(prime);
-        double fractional = squareRoot - std::floor(squareRoot);
-        uint32_t value = static_cast<uint32_t>(fractional * std::pow(2, 32));
-        initial.push_back(value);
-    }
-    return initial;
-}
-
-const std::vector<uint32_t> K = calculateK();
-const std::vector<uint32_t> IV = calculateIV();
-
-// ============ SHA-256 Core Functions ============
-
-std::string padding(const std::string& message) {
-    size_t l = message.size();
-    int k = (448 - static_cast<int>(l) - 1) % 512;
-    if (k < 0) k += 512;
-    
-    std::string l64 = bits64(l, 64);
-    return message + "1" + std::string(k, '0') + l64;
-}
-
-std::vector<std::string> split(const std::string& message, int size = 512) {
-    std::vector<std::string> blocks;
-    for (size_t i = 0; i < message.length(); i += size) {
-        blocks.push_back(message.substr(i, size));
-    }
-    return blocks;
+// Bits [first, first + count) of the padded message, built from the
+// bytes; the overview builds only the ends that fit after `label`
+std::string fitBits(uint64_t first, uint64_t count, size_t label) {
+    if (!g_overview) return padded_bits(g_bytes.data(), g_bytes.size(), first, count);
+    int width, height;
+    frame_renderer().size(width, height);
+    uint64_t ends = std::min<uint64_t>(width, count);
+    std::string head = padded_bits(g_bytes.data(), g_bytes.size(), first, ends);
+    std::string tail = padded_bits(g_bytes.data(), g_bytes.size(), first + count - ends, ends);
+    return elide(head, tail, count, static_cast<size_t>(width) > label ? width - label : 1);
 }
 
-std::vector<uint32_t> calculate_schedule(const std::string& block) {
-    std::vector<uint32_t> schedule;
-
-    for (size_t i = 0; i < 16; i++) {
-        std::string word = block.substr(i * 32, 32);
-        schedule.push_back(std::bitset<32>(word).to_ulong());
-    }
-
-    for (int i = 16; i <= 63; i++) {
-        schedule.push_back(add(sigma1(schedule[i - 2]), 
-                               schedule[i - 7], 
-                               sigma0(schedule[i - 15]), 
-                               schedule[i - 16]));
-    }
-    return schedule;
-}
-
-std::vector<uint32_t> compression(const std::vector<uint32_t>& initial, 
-                                  const std::vector<uint32_t>& schedule) {
-    uint32_t h = initial[7];
-    uint32_t g = initial[6];
-    uint32_t f = initial[5];
-    uint32_t e = initial[4];
-    uint32_t d = initial[3];
-    uint32_t c = initial[2];
-    uint32_t b = initial[1];
-    uint32_t a = initial[0];
-
-    for (int i = 0; i < 64; i++) {
-        uint32_t t1 = add(schedule[i], K[i], usigma1(e), ch(e, f, g), h);
-        uint32_t t2 = add(usigma0(a), maj(a, b, c));
-
-        h = g;
-        g = f;
-        f = e;
-        e = add(d, t1);
-        d = c;
-        c = b;
-        b = a;
-        a = add(t1, t2);
+std::string stringToBinary(const std::string& str) {
+    std::string result;
+    for (unsigned char c : str) {
+        result += std::bitset<8>(c).to_string();
     }
-
-    std::vector<uint32_t> hash(8);
-    hash[7] = add(initial[7], h);
-    hash[6] = add(initial[6], g);
-    hash[5] = add(initial[5], f);
-    hash[4] = add(initial[4], e);
-    hash[3] = add(initial[3], d);
-    hash[2] = add(initial[2], c);
-    hash[1] = add(initial[1], b);
-    hash[0] = add(initial[0], a);
-
-    return hash;
+    return result;
 }
 
 // ============ Message Visualization ============
 
 void showMessage() {
+    std::string input = fit(g_input, 11 + g_type.size() + 3);
+
+    // Lengths of the whole texts, which the overview never builds
+    uint64_t n = g_bytes.size();
+    uint64_t digits = 0;
+    for (uint8_t byte : g_bytes) digits += byte >= 100 ? 3 : byte >= 10 ? 2 : 1;
+    std::string inspect = fitBytes(bytesInspect, n ? digits + 2 * n : 2, 9);
+    std::string binary = fitBytes(bytesToBinary, n ? 9 * n - 1 : 0, 9);
+    std::string hexed = fitBytes(bytesToHex, 2 * n, 11);
+
     clearScreen();
     std::cout << "========================================" << std::endl;
     std::cout << "STEP 1: Original Message" << std::endl;
@@ -288,7 +132,7 @@ void showMessage() {
     std::cout << "-------" << std::endl;
     std::cout << "message:" << std::endl;
     std::cout << "-------" << std::endl;
-    std::cout << "input:   \"" << g_input << "\" (" << g_type << ")" << std::endl;
+    std::cout << "input:   \"" << input << "\" (" << g_type << ")" << std::endl;
     delay("normal");
     
     clearScreen();
@@ -298,8 +142,8 @@ void showMessage() {
     std::cout << "-------" << std::endl;
     std::cout << "message:" << std::endl;
     std::cout << "-------" << std::endl;
-    std::cout << "input:   \"" << g_input << "\" (" << g_type << ")" << std::endl;
-    std::cout << "bytes:   " << bytesInspect(g_bytes) << std::endl;
+    std::cout << "input:   \"" << input << "\" (" << g_type << ")" << std::endl;
+    std::cout << "bytes:   " << inspect << std::endl;
     delay("normal");
     
     clearScreen();
@@ -309,20 +153,15 @@ void showMessage() {
     std::cout << "-------" << std::endl;
     std::cout << "message:" << std::endl;
     std::cout << "-------" << std::endl;
-    std::cout << "input:   \"" << g_input << "\" (" << g_type << ")" << std::endl;
-    std::cout << "bytes:   " << bytesInspect(g_bytes) << std::endl;
+    std::cout << "input:   \"" << input << "\" (" << g_type << ")" << std::endl;
+    std::cout << "bytes:   " << inspect << std::endl;
     
     // Show binary with byte grouping
-    std::cout << "message: ";
-    for (size_t i = 0; i < g_bytes.size(); i++) {
-        std::cout << std::bitset<8>(g_bytes[i]).to_string();
-        if (i < g_bytes.size() - 1) std::cout << " ";
-    }
-    std::cout << std::endl;
+    std::cout << "message: " << binary << std::endl;
     
     // Show hex representation
-    std::cout << "hex:     0x" << bytesToHex(g_bytes) << std::endl;
-    std::cout << "length:  " << g_message.length() << " bits" << std::endl;
+    std::cout << "hex:     0x" << hexed << std::endl;
+    std::cout << "length:  " << g_bytes.size() * 8 << " bits" << std::endl;
     delay("end");
     
     // Save state
@@ -330,9 +169,9 @@ void showMessage() {
     ss << "-------" << std::endl;
     ss << "message:" << std::endl;
     ss << "-------" << std::endl;
-    ss << "input:   \"" << g_input << "\" (" << g_type << ")" << std::endl;
-    ss << "bytes:   " << bytesInspect(g_bytes) << std::endl;
-    ss << "message: " << g_message << std::endl;
+    ss << "input:   \"" << input << "\" (" << g_type << ")" << std::endl;
+    ss << "bytes:   " << inspect << std::endl;
+    ss << "message: " << fitBits(0, g_bytes.size() * 8, 9) << std::endl;
     g_state = ss.str();
 }
 
@@ -340,11 +179,13 @@ void showMessage() {
 
 void showPadding() {
     // Calculate padding values
-    g_l = g_message.size();
-    g_k = (448 - static_cast<int>(g_l) - 1) % 512;
-    if (g_k < 0) g_k += 512;
+    g_l = g_bytes.size() * 8;
+    g_k = static_cast<int>((447 - g_l % 512 + 512) % 512);
     std::string length_bits = bits64(g_l, 64);
-    g_padded = g_message + "1" + std::string(g_k, '0') + length_bits;
+    size_t padded_len = g_l + 1 + g_k + 64;
+    
+    // The overview keeps the ends of the message, where the padding goes
+    std::string message = fitBits(0, g_l, 10);
     
     // Frame 1: Padding title
     clearScreen();
@@ -369,7 +210,7 @@ void showPadding() {
     std::cout << "-------" << std::endl;
     std::cout << "padding: (" << g_l << " bits)" << std::endl;
     std::cout << "-------" << std::endl;
-    std::cout << "message: " << g_message << std::endl;
+    std::cout << "message: " << message << std::endl;
     std::cout << "\nOriginal length: " << g_l << " bits" << std::endl;
     delay("normal");
     
@@ -382,8 +223,8 @@ void showPadding() {
     std::cout << "-------" << std::endl;
     std::cout << "padding: (" << (g_l + 1) << " bits)" << std::endl;
     std::cout << "-------" << std::endl;
-    std::cout << "message: " << g_message << "\033[33m1\033[0m" << std::endl;
-    std::cout << "         " << std::string(g_message.length(), ' ') << "^" << std::endl;
+    std::cout << "message: " << message << "\033[33m1\033[0m" << std::endl;
+    std::cout << "         " << std::string(message.length(), ' ') << "^" << std::endl;
     std::cout << "Step 1: Append '1' bit" << std::endl;
     delay("normal");
     
@@ -397,7 +238,7 @@ void showPadding() {
     std::cout << "padding: (" << (g_l + 1) << " bits → " << (g_l + 1 + g_k) << " bits)" << std::endl;
     std::cout << "-------" << std::endl;
     
-    std::cout << "message: " << g_message << "\033[33m1\033[0m";
+    std::cout << "message: " << message << "\033[33m1\033[0m";
     std::cout.flush();
     
     int display_count = 0;
@@ -415,7 +256,7 @@ void showPadding() {
                 std::cout.flush();
             }
             
-            delayMilliseconds(5);
+            delay(5);
         }
     }
     std::cout << "\033[0m" << std::endl;
@@ -432,7 +273,7 @@ void showPadding() {
     std::cout << "-------" << std::endl;
     std::cout << "padding: (" << (g_l + 1 + g_k) << " bits)" << std::endl;
     std::cout << "-------" << std::endl;
-    std::cout << "message: " << g_message << "\033[33m1\033[0m\033[34m" << std::string(g_k, '0') << "\033[0m" << std::endl;
+    std::cout << "message: " << message << "\033[33m1\033[0m\033[34m" << std::string(g_k, '0') << "\033[0m" << std::endl;
     std::cout << "\nNeed 64 more bits for original length" << std::endl;
     delay("normal");
     
@@ -445,7 +286,7 @@ void showPadding() {
     std::cout << "-------" << std::endl;
     std::cout << "padding: (" << (g_l + 1 + g_k + 64) << " bits)" << std::endl;
     std::cout << "-------" << std::endl;
-    std::cout << "message: " << g_message << "\033[33m1\033[0m\033[34m" << std::string(g_k, '0') << "\033[0m\033[35m" << length_bits << "\033[0m" << std::endl;
+    std::cout << "message: " << message << "\033[33m1\033[0m\033[34m" << std::string(g_k, '0') << "\033[0m\033[35m" << length_bits << "\033[0m" << std::endl;
     std::cout << "\nStep 3: Append 64-bit original length: " << g_l << " = " << length_bits << std::endl;
     delay("normal");
     
@@ -456,19 +297,19 @@ void showPadding() {
     std::cout << "STEP 2: Message Padding - COMPLETE" << std::endl;
     std::cout << "========================================" << std::endl;
     std::cout << "-------" << std::endl;
-    std::cout << "padding: (" << g_padded.size() << " bits)" << std::endl;
+    std::cout << "padding: (" << padded_len << " bits)" << std::endl;
     std::cout << "-------" << std::endl;
     
     std::cout << "message: ";
-    std::cout << "\033[32m" << g_message << "\033[0m";     // original - green
+    std::cout << "\033[32m" << message << "\033[0m";     // original - green
     std::cout << "\033[33m1\033[0m";                       // '1' bit - yellow
     std::cout << "\033[34m" << std::string(g_k, '0') << "\033[0m"; // zeros - blue
     std::cout << "\033[35m" << length_bits << "\033[0m";   // length - magenta
     std::cout << std::endl;
     
     std::cout << "\nLegend: \033[32moriginal\033[0m \033[33m+1\033[0m \033[34m+zeros\033[0m \033[35m+length\033[0m" << std::endl;
-    std::cout << "Final length: " << g_padded.size() << " bits = " 
-              << (g_padded.size() / 512) << " × 512-bit blocks" << std::endl;
+    std::cout << "Final length: " << padded_len << " bits = " 
+              << (padded_len / 512) << " × 512-bit blocks" << std::endl;
     delay("slow");
     
     // Frame 8: Final - just the padded message
@@ -478,14 +319,20 @@ void showPadding() {
     std::cout << "STEP 2: Message Padding - FINAL" << std::endl;
     std::cout << "========================================" << std::endl;
     std::cout << "-------" << std::endl;
-    std::cout << "padding: (" << g_padded.size() << " bits)" << std::endl;
+    std::cout << "padding: (" << padded_len << " bits)" << std::endl;
     std::cout << "-------" << std::endl;
     
     // Show wrapped for readability
     std::cout << "message: ";
-    for (size_t i = 0; i < g_padded.size(); i += 64) {
+    for (size_t i = 0; i < padded_len; i += 64) {
+        // The overview keeps four rows at either end
+        if (g_overview && i == 4 * 64 && padded_len > 8 * 64) {
+            std::cout << "         ...[" << (padded_len - 8 * 64) << " more]..." << std::endl;
+            i = padded_len - 5 * 64;
+            continue;
+        }
         if (i > 0) std::cout << "         ";
-        std::cout << g_padded.substr(i, std::min<size_t>(64, g_padded.size() - i)) << std::endl;
+        std::cout << padded_bits(g_bytes.data(), g_bytes.size(), i, 64) << std::endl;
     }
     delay("end");
     
@@ -493,42 +340,84 @@ void showPadding() {
     std::stringstream ss;
     ss << g_state << "\n";
     ss << "-------" << std::endl;
-    ss << "padding: (" << g_padded.size() << " bits)" << std::endl;
+    ss << "padding: (" << padded_len << " bits)" << std::endl;
     ss << "-------" << std::endl;
-    ss << "message: " << g_padded << std::endl;
+    ss << "message: " << fitBits(0, padded_len, 9) << std::endl;
     g_state = ss.str();
 }
 
 // ============ Blocks Visualization ============
 
-void showBlocks() {
+void showBlocks(const Sha256Trace& trace) {
     clearScreen();
     std::cout << g_state << "\n" << std::endl;
     std::cout << "========================================" << std::endl;
     std::cout << "STEP 3: Message Blocks" << std::endl;
     std::cout << "========================================" << std::endl;
-    std::cout << g_blocks.size() << " block(s) of 512 bits" << std::endl;
+    std::cout << trace.blocks() << " block(s) of 512 bits" << std::endl;
     std::cout << std::endl;
     
-    for (size_t i = 0; i < g_blocks.size(); i++) {
+    for (size_t i = 0; i < trace.blocks(); i++) {
         std::cout << "Block " << i << ":" << std::endl;
-        std::string block = g_blocks[i];
+        const uint32_t* w = trace.schedule(i);
         
         // Show block as 16 words of 32 bits
         for (int j = 0; j < 16; j++) {
             std::cout << "  W" << std::setw(2) << j << ": " 
-                      << block.substr(j * 32, 32);
+                      << std::bitset<32>(w[j]).to_string();
             if (j % 4 == 3) std::cout << std::endl;
             else std::cout << "  ";
         }
         
-        if (i < g_blocks.size() - 1) {
+        if (i < trace.blocks() - 1) {
             std::cout << "---" << std::endl;
         }
     }
     delay("slow");
 }
 
+// ============ Block Overview ============
+
+// One shaded cell per run of blocks instead of every block's bits; only
+// the selected block's words are printed
+void showBlockOverview(const TraceOverview& overview, const Sha256Trace& trace) {
+    int width, height;
+    frame_renderer().size(width, height);
+
+    clearScreen();
+    std::cout << g_state << "\n" << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << "STEP 3: Message Blocks (overview)" << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << overview.blocks() << " blocks of 512 bits, block " << g_selected << " selected" << std::endl;
+    std::cout << std::endl;
+    std::cout << overview.block_map(width, std::max(1, height / 4), g_selected);
+    std::cout << std::endl;
+    
+    std::cout << "Block " << g_selected << ":" << std::endl;
+    const uint32_t* w = trace.schedule(g_selected);
+    for (int j = 0; j < 16; j++) {
+        std::cout << "  W" << std::setw(2) << j << ": " 
+                  << std::bitset<32>(w[j]).to_string();
+        if (j % 4 == 3) std::cout << std::endl;
+        else std::cout << "  ";
+    }
+    delay("slow");
+}
+
+void showRoundOverview(const TraceOverview& overview, size_t block_num) {
+    clearScreen();
+    std::cout << g_state << "\n" << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << "STEP 6: Compression (Block " << block_num << " of " << overview.blocks() << ")" << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << "Bits flipped per register and round:" << std::endl;
+    std::cout << overview.round_map(block_num);
+    std::cout << std::endl;
+    std::cout << "Total: " << overview.block_flips(block_num) << " bits" << std::endl;
+    delay("slow");
+}
+
 // ============ Initial Hash Visualization ============
 
 void showInitialHash() {
@@ -579,7 +468,7 @@ void showSchedule(const std::vector<uint32_t>& schedule, int block_num) {
 
 // ============ Compression Round Visualization ============
 
-void showCompressionRound(const std::vector<uint32_t>& hash, int round, int total_rounds) {
+void showCompressionRound(const TraceRound& state, int round, int total_rounds) {
     clearScreen();
     std::cout << g_state << "\n" << std::endl;
     std::cout << "========================================" << std::endl;
@@ -589,9 +478,11 @@ void showCompressionRound(const std::vector<uint32_t>& hash, int round, int tota
     std::string registers[] = {"a", "b", "c", "d", "e", "f", "g", "h"};
     
     for (int i = 0; i < 8; i++) {
-        std::cout << registers[i] << " = " << bits(hash[i]) 
-                  << " (0x" << hex(hash[i]) << ")" << std::endl;
+        std::cout << registers[i] << " = " << bits(state.reg[i]) 
+                  << " (0x" << hex(state.reg[i]) << ")" << std::endl;
     }
+    std::cout << "T1 = " << bits(state.t1) << " (0x" << hex(state.t1) << ")" << std::endl;
+    std::cout << "T2 = " << bits(state.t2) << " (0x" << hex(state.t2) << ")" << std::endl;
     
     delay("fast");
 }
@@ -654,7 +545,7 @@ void showPaddingDiagram() {
     std::cout << "|";
     
     // Message section
-    int msg_chars = std::min(static_cast<int>(g_message.length() / 8), 20);
+    int msg_chars = std::min(static_cast<int>(g_l / 8), 20);
     for (int i = 0; i < msg_chars; i++) std::cout << " ";
     std::cout << "M";
     for (int i = 0; i < msg_chars; i++) std::cout << " ";
@@ -677,19 +568,48 @@ void showPaddingDiagram() {
     // Statistics
     std::cout << "Message length: " << g_l << " bits" << std::endl;
     std::cout << "Padding zeros:  " << g_k << " bits" << std::endl;
-    std::cout << "Total length:   " << g_padded.size() << " bits" << std::endl;
-    std::cout << "Blocks:         " << (g_padded.size() / 512) << " × 512-bit blocks" << std::endl;
+    size_t padded_len = g_l + 1 + g_k + 64;
+    std::cout << "Total length:   " << padded_len << " bits" << std::endl;
+    std::cout << "Blocks:         " << (padded_len / 512) << " × 512-bit blocks" << std::endl;
+}
+
+// ============ Block Replay ============
+
+void showBlockSchedule(const Sha256Trace& trace, size_t block_num) {
+    const uint32_t* w = trace.schedule(block_num);
+    showSchedule(std::vector<uint32_t>(w, w + 64), block_num);
+}
+
+// Sample compression rounds
+void showSampleRounds(const Sha256Trace& trace, size_t block_num) {
+    for (int round = 0; round < 64; round += 16) {
+        showCompressionRound(trace.round(block_num, round), round, 64);
+    }
 }
 
 // ============ Main SHA-256 Function ============
 
-std::string sha256(const std::string& input) {
+std::string animateSha256(const std::string& input) {
     g_input = input;
-    g_bytes.clear();
-    for (char c : g_input) {
-        g_bytes.push_back(static_cast<uint8_t>(c));
+    if (g_type == "string") {
+        g_bytes.clear();
+        for (char c : g_input) {
+            g_bytes.push_back(static_cast<uint8_t>(c));
+        }
+    }
+
+    // Messages larger than the screen are summarised per block
+    g_overview = overview_needed(g_bytes.size());
+    g_selected = std::min<size_t>(g_selected, padded_blocks(g_bytes.size()) - 1);
+
+    // Run the whole computation up front, unless a saved trace was given;
+    // the frames below only replay it. The overview keeps only the
+    // selected block in full (800 bytes) and a 4-byte count for the rest
+    const Sha256Trace& trace = g_trace;
+    if (g_type != "trace") {
+        if (g_overview) g_trace.record(g_bytes.data(), g_bytes.size(), g_selected, 1);
+        else g_trace.record(g_bytes.data(), g_bytes.size());
     }
-    g_message = bytesToBinary(g_bytes);
     
     // STEP 1: Show message
     showMessage();
@@ -702,31 +622,27 @@ std::string sha256(const std::string& input) {
         showPaddingDiagram();
     }
     
-    // Split into blocks
-    g_blocks = split(g_padded, 512);
-    showBlocks();
-    
     // Initialize hash
-    g_hash = IV;
-    showInitialHash();
-    
-    // Process each block
-    for (size_t block_num = 0; block_num < g_blocks.size(); block_num++) {
-        // Calculate message schedule
-        std::vector<uint32_t> schedule = calculate_schedule(g_blocks[block_num]);
-        showSchedule(schedule, block_num);
-        
-        // Remember starting hash
-        std::vector<uint32_t> initial = g_hash;
-        
-        // Show sample compression rounds
-        for (int round = 0; round < 64; round += 16) {
-            showCompressionRound(g_hash, round, 64);
+    std::copy(IV.begin(), IV.end(), g_hash.begin());
+    
+    // Blocks, then each block replayed from the trace. The overview only
+    // expands the selected block
+    if (g_overview) {
+        TraceOverview overview(trace);
+        showBlockOverview(overview, trace);
+        showInitialHash();
+        showBlockSchedule(trace, g_selected);
+        showRoundOverview(overview, g_selected);
+        showSampleRounds(trace, g_selected);
+    } else {
+        showBlocks(trace);
+        showInitialHash();
+        for (size_t block_num = 0; block_num < trace.blocks(); block_num++) {
+            showBlockSchedule(trace, block_num);
+            showSampleRounds(trace, block_num);
         }
-        
-        // Apply compression
-        g_hash = compression(initial, schedule);
     }
+    g_hash = trace.final_state();
     
     // Show final hash
     showFinalHash();
@@ -737,13 +653,42 @@ std::string sha256(const std::string& input) {
 // ============ Main ============
 
 int main(int argc, char* argv[]) {
-    // Parse command line arguments
-    if (argc >= 2) {
-        g_input = argv[1];
+    // Parse command line arguments; "--trace FILE" replays a trace saved
+    // by sha_program --trace in place of the input
+    int first = 1;
+    if (argc >= 3 && std::string(argv[1]) == "--trace") {
+        g_type = "trace";
+        first = 2;
+    }
+    
+    if (argc > first) {
+        g_input = argv[first];
+    }
+    
+    if (argc > first + 1) {
+        g_delay = argv[first + 1];
+    }
+    
+    // Block to expand when the message is shown as an overview
+    if (argc > first + 2) {
+        g_selected = std::strtoul(argv[first + 2], nullptr, 10);
     }
     
-    if (argc >= 3) {
-        g_delay = argv[2];
+    // A file is hashed by its contents; the path stays as the label
+    std::ifstream file(g_input, std::ios::binary);
+    if (g_type == "trace") {
+        std::vector<uint8_t> saved;
+        if (file.good()) {
+            saved.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        }
+        if (!g_trace.load(saved.data(), saved.size())) {
+            std::cerr << "Not a valid trace: " << g_input << std::endl;
+            return 1;
+        }
+        g_bytes = g_trace.message();
+    } else if (file.good()) {
+        g_type = "file";
+        g_bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
     }
     
     // Note about hitting enter to step
@@ -752,8 +697,11 @@ int main(int argc, char* argv[]) {
         std::cin.get();
     }
     
+    // Compose each frame in memory; only the changed cells are redrawn
+    frame_renderer().attach();
+
     // Run the complete SHA-256 visualization
-    std::string result = sha256(g_input);
+    std::string result = animateSha256(g_input);
     
     return 0;
 }
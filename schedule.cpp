@@ -9,6 +9,9 @@
 #include <cmath>
 #include <cstdint>
 #include <algorithm>
+#include <cstdlib>
+
+#include "SHA.h"
 
 // ============ Global Variables ============
 std::string g_input = "abc";
@@ -20,69 +23,16 @@ std::string g_block;
 std::vector<uint32_t> g_schedule;
 std::vector<std::vector<uint32_t>> g_memory;
 std::string g_state;
-std::string g_delay = "normal";
 std::string indent = "  ";
 
 // ============ Utility Functions ============
 
-void clearScreen() {
-    std::cout << "\033[2J\033[1;1H";
-}
-
-void delay(const std::string& speed) {
-    if (g_delay == "enter") {
-        std::cin.get();
-    } else if (g_delay == "nodelay") {
-        std::this_thread::sleep_for(std::chrono::milliseconds(0));
-    } else {
-        double multiplier = 1.0;
-        if (g_delay == "fast") multiplier = 0.5;
-        
-        int sleepTime = 0;
-        if (speed == "fastest") sleepTime = 100 * multiplier;
-        else if (speed == "fast") sleepTime = 200 * multiplier;
-        else if (speed == "normal") sleepTime = 400 * multiplier;
-        else if (speed == "slow") sleepTime = 600 * multiplier;
-        else if (speed == "slowest") sleepTime = 800 * multiplier;
-        else if (speed == "end") sleepTime = 1000 * multiplier;
-        
-        std::this_thread::sleep_for(std::chrono::milliseconds(sleepTime));
-    }
-}
-
-std::string bits(uint32_t x) {
-    return std::bitset<32>(x).to_string();
-}
-
 std::string formatWord(int i) {
     std::string s = std::to_string(i);
     if (s.length() == 1) return " " + s;
     return s;
 }
 
-// ============ SHA-256 Operations ============
-
-uint32_t rotr(int n, uint32_t x) {
-    return (x >> n) | (x << (32 - n));
-}
-
-uint32_t shr(int n, uint32_t x) {
-    return x >> n;
-}
-
-uint32_t sigma0(uint32_t x) {
-    return rotr(7, x) ^ rotr(18, x) ^ shr(3, x);
-}
-
-uint32_t sigma1(uint32_t x) {
-    return rotr(17, x) ^ rotr(19, x) ^ shr(10, x);
-}
-
-uint32_t add(uint32_t a, uint32_t b, uint32_t c, uint32_t d) {
-    uint64_t total = static_cast<uint64_t>(a) + b + c + d;
-    return static_cast<uint32_t>(total & 0xFFFFFFFF);
-}
-
 // ============ Padding and Block Functions ============
 
 std::string stringToBinary(const std::string& str) {
@@ -93,23 +43,6 @@ std::string stringToBinary(const std::string& str) {
     return result;
 }
 
-std::string padding(const std::string& message) {
-    size_t l = message.size();
-    int k = (448 - static_cast<int>(l) - 1) % 512;
-    if (k < 0) k += 512;
-    
-    std::string l64 = std::bitset<64>(l).to_string();
-    return message + "1" + std::string(k, '0') + l64;
-}
-
-std::vector<std::string> split(const std::string& message, int size = 512) {
-    std::vector<std::string> blocks;
-    for (size_t i = 0; i < message.length(); i += size) {
-        blocks.push_back(message.substr(i, size));
-    }
-    return blocks;
-}
-
 // ============ Message Schedule Calculation ============
 
 void calculateSchedule() {
@@ -306,13 +239,20 @@ int main(int argc, char* argv[]) {
         g_delay = argv[2];
     }
     
+    // Only one block is ever expanded; long inputs can pick which
+    if (argc >= 4) {
+        g_block_number = std::atoi(argv[3]);
+    }
+    
     // If no block provided, generate from default input
     if (g_block.empty()) {
         g_message = stringToBinary(g_input);
         g_padded = padding(g_message);
         g_blocks = split(g_padded, 512);
-        g_block_number = 0;
+        g_block_number = std::max(0, std::min(g_block_number, static_cast<int>(g_blocks.size()) - 1));
         g_block = g_blocks[g_block_number];
+    } else {
+        g_block_number = 0;
     }
     
     // Calculate the message schedule
@@ -324,6 +264,9 @@ int main(int argc, char* argv[]) {
         std::cin.get();
     }
     
+    // Compose each frame in memory; only the changed cells are redrawn
+    frame_renderer().attach();
+
     // Show visualization
     showMessageSchedule();
     
@@ -0,0 +1,497 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "SHA.h"
+
+// ============ Multi-Buffer Batch Hashing ============
+// Hashes N independent messages at once, one message per vector lane.
+// The round logic is written once against GCC vector types and compiled
+// for SSE2 (4 lanes), AVX2 (8 lanes) and AVX-512 (16 lanes); the widest
+// one the CPU supports is picked at runtime.
+
+namespace {
+
+typedef uint32_t u32x4 __attribute__((vector_size(16)));
+typedef uint32_t u32x8 __attribute__((vector_size(32)));
+typedef uint32_t u32x16 __attribute__((vector_size(64)));
+
+// ============ Lane-Wise Functions ============
+// Same expressions as the scalar kernel; with GCC vector types every
+// operator applies to all lanes at once.
+
+#define LANE_ROTR(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
+#define LANE_SIGMA0(x) (LANE_ROTR(x, 7) ^ LANE_ROTR(x, 18) ^ ((x) >> 3))
+#define LANE_SIGMA1(x) (LANE_ROTR(x, 17) ^ LANE_ROTR(x, 19) ^ ((x) >> 10))
+#define LANE_USIGMA0(x) (LANE_ROTR(x, 2) ^ LANE_ROTR(x, 13) ^ LANE_ROTR(x, 22))
+#define LANE_USIGMA1(x) (LANE_ROTR(x, 6) ^ LANE_ROTR(x, 11) ^ LANE_ROTR(x, 25))
+#define LANE_CH(x, y, z) ((z) ^ ((x) & ((y) ^ (z))))
+#define LANE_MAJ(x, y, z) (((x) & (y)) | ((z) & ((x) | (y))))
+
+// One block per lane, already as words: w[i] holds word i of every
+// lane's block (used as the rolling schedule window, so it is clobbered).
+// state[r] holds register r of every lane.
+template <typename V>
+__attribute__((always_inline)) inline void compress_words(V* state, V* w) {
+    V a = state[0];
+    V b = state[1];
+    V c = state[2];
+    V d = state[3];
+    V e = state[4];
+    V f = state[5];
+    V g = state[6];
+    V h = state[7];
+
+    #pragma GCC unroll 64
+    for (int i = 0; i < 64; i++) {
+        if (i >= 16) {
+            w[i & 15] += LANE_SIGMA1(w[(i - 2) & 15]) + w[(i - 7) & 15] + LANE_SIGMA0(w[(i - 15) & 15]);
+        }
+        V t1 = h + LANE_USIGMA1(e) + LANE_CH(e, f, g) + K[i] + w[i & 15];
+        V t2 = LANE_USIGMA0(a) + LANE_MAJ(a, b, c);
+
+        h = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
+
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+}
+
+// One block per lane. state[r] holds register r of every lane,
+// blocks[lane] points at that lane's 64-byte block.
+template <typename V, int N>
+__attribute__((always_inline)) inline void compress_lanes(V* state, const uint8_t* const* blocks) {
+    // transpose: w[i] = word i of every lane's block
+    uint32_t words[16][N];
+    for (int lane = 0; lane < N; lane++) {
+        for (int i = 0; i < 16; i++) {
+            uint32_t word;
+            std::memcpy(&word, blocks[lane] + i * 4, 4);
+            words[i][lane] = __builtin_bswap32(word);
+        }
+    }
+    V w[16];
+    std::memcpy(w, words, sizeof(w));
+    compress_words<V>(state, w);
+}
+
+// HMAC iterations U = HMAC(K, U), T ^= U on every lane, for PBKDF2.
+// U is 32 bytes and follows a 64-byte keyed block, so both compressions
+// use a fixed padding block (length 768 bits) and never leave registers.
+// All arrays are word-major: x[r * N + lane].
+template <typename V, int N>
+__attribute__((always_inline)) inline void hmac_iterate(const uint32_t* inner, const uint32_t* outer,
+                                                        uint32_t* u, uint32_t* t, uint32_t rounds) {
+    V in[8], out[8], uu[8], tt[8];
+    std::memcpy(in, inner, sizeof(in));
+    std::memcpy(out, outer, sizeof(out));
+    std::memcpy(uu, u, sizeof(uu));
+    std::memcpy(tt, t, sizeof(tt));
+
+    const V zero = {};
+    for (uint32_t it = 0; it < rounds; it++) {
+        V w[16];
+        V s[8];
+        for (int r = 0; r < 8; r++) {
+            w[r] = uu[r];
+            s[r] = in[r];
+        }
+        w[8] = zero + 0x80000000u;
+        for (int r = 9; r < 15; r++) w[r] = zero;
+        w[15] = zero + 768u;
+        compress_words<V>(s, w);
+
+        for (int r = 0; r < 8; r++) {
+            w[r] = s[r];
+            s[r] = out[r];
+        }
+        w[8] = zero + 0x80000000u;
+        for (int r = 9; r < 15; r++) w[r] = zero;
+        w[15] = zero + 768u;
+        compress_words<V>(s, w);
+
+        for (int r = 0; r < 8; r++) {
+            uu[r] = s[r];
+            tt[r] ^= s[r];
+        }
+    }
+
+    std::memcpy(u, uu, sizeof(uu));
+    std::memcpy(t, tt, sizeof(tt));
+}
+
+// ============ Per-ISA Kernels ============
+
+using LaneKernel = void (*)(uint32_t* state, const uint8_t* const* blocks);
+using IterateKernel = void (*)(const uint32_t* inner, const uint32_t* outer,
+                               uint32_t* u, uint32_t* t, uint32_t rounds);
+
+void compress_x4(uint32_t* state, const uint8_t* const* blocks) {
+    u32x4 s[8];
+    std::memcpy(s, state, sizeof(s));
+    compress_lanes<u32x4, 4>(s, blocks);
+    std::memcpy(state, s, sizeof(s));
+}
+
+void hmac_iterate_x4(const uint32_t* inner, const uint32_t* outer,
+                     uint32_t* u, uint32_t* t, uint32_t rounds) {
+    hmac_iterate<u32x4, 4>(inner, outer, u, t, rounds);
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+
+__attribute__((target("avx2")))
+void compress_x8(uint32_t* state, const uint8_t* const* blocks) {
+    u32x8 s[8];
+    std::memcpy(s, state, sizeof(s));
+    compress_lanes<u32x8, 8>(s, blocks);
+    std::memcpy(state, s, sizeof(s));
+}
+
+__attribute__((target("avx512f")))
+void compress_x16(uint32_t* state, const uint8_t* const* blocks) {
+    u32x16 s[8];
+    std::memcpy(s, state, sizeof(s));
+    compress_lanes<u32x16, 16>(s, blocks);
+    std::memcpy(state, s, sizeof(s));
+}
+
+__attribute__((target("avx2")))
+void hmac_iterate_x8(const uint32_t* inner, const uint32_t* outer,
+                     uint32_t* u, uint32_t* t, uint32_t rounds) {
+    hmac_iterate<u32x8, 8>(inner, outer, u, t, rounds);
+}
+
+__attribute__((target("avx512f")))
+void hmac_iterate_x16(const uint32_t* inner, const uint32_t* outer,
+                      uint32_t* u, uint32_t* t, uint32_t rounds) {
+    hmac_iterate<u32x16, 16>(inner, outer, u, t, rounds);
+}
+
+#endif
+
+// Widest lane count the CPU supports, or SHA256_LANES=1/4/8/16 to force one
+size_t detect_lanes() {
+    size_t lanes = 4;
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) lanes = 16;
+    else if (__builtin_cpu_supports("avx2")) lanes = 8;
+#endif
+    const char* forced = std::getenv("SHA256_LANES");
+    if (forced != nullptr) {
+        size_t n = std::strtoul(forced, nullptr, 10);
+        if ((n == 1 || n == 4 || n == 8 || n == 16) && n <= lanes) {
+            lanes = n;
+        }
+    }
+    return lanes;
+}
+
+LaneKernel kernel_for(size_t lanes) {
+#if defined(__x86_64__) || defined(__i386__)
+    if (lanes == 16) return compress_x16;
+    if (lanes == 8) return compress_x8;
+#endif
+    return compress_x4;
+}
+
+// One job at a time, for one lane, or when SHA-NI would be up against
+// only 4 SSE2 lanes: SHA-NI on its own beats those
+bool prefer_single_lane(size_t lanes) {
+    return lanes == 1 || (lanes == 4 && sha256_get_backend() == Sha256Backend::ShaNi);
+}
+
+IterateKernel iterate_kernel_for(size_t lanes) {
+#if defined(__x86_64__) || defined(__i386__)
+    if (lanes == 16) return hmac_iterate_x16;
+    if (lanes == 8) return hmac_iterate_x8;
+#endif
+    return hmac_iterate_x4;
+}
+
+// The up-to-two padded tail blocks of one message
+struct Tail {
+    uint8_t bytes[128];
+    size_t full;   // blocks that can be read straight from the message
+};
+
+// `prefix` bytes were already compressed into the starting state; they
+// only count towards the encoded length
+void make_tail(const ByteView& msg, uint64_t prefix, Tail& tail) {
+    tail.full = msg.size / 64;
+    size_t rest = msg.size - tail.full * 64;
+    size_t total = padded_blocks(msg.size) - tail.full;
+
+    std::memset(tail.bytes, 0, sizeof(tail.bytes));
+    if (rest > 0) {
+        std::memcpy(tail.bytes, msg.data + tail.full * 64, rest);
+    }
+    tail.bytes[rest] = 0x80;
+
+    uint64_t bits = (prefix + msg.size) * 8;
+    uint8_t* end = tail.bytes + total * 64;
+    for (int i = 1; i <= 8; i++) {
+        end[-i] = static_cast<uint8_t>(bits);
+        bits >>= 8;
+    }
+}
+
+uint32_t load_word(const Digest& digest, int r) {
+    const uint8_t* p = digest.data() + r * 4;
+    return static_cast<uint32_t>(p[0]) << 24 | static_cast<uint32_t>(p[1]) << 16 |
+           static_cast<uint32_t>(p[2]) << 8 | static_cast<uint32_t>(p[3]);
+}
+
+void store_digest(const uint32_t* state, size_t stride, size_t lane, Digest& out) {
+    for (int r = 0; r < 8; r++) {
+        uint32_t v = state[r * stride + lane];
+        out[r * 4 + 0] = static_cast<uint8_t>(v >> 24);
+        out[r * 4 + 1] = static_cast<uint8_t>(v >> 16);
+        out[r * 4 + 2] = static_cast<uint8_t>(v >> 8);
+        out[r * 4 + 3] = static_cast<uint8_t>(v);
+    }
+}
+
+// Hash up to `lanes` messages together. Lanes beyond `count` repeat the
+// last message and are discarded; lanes that finish early keep running on
+// their last block until the longest one is done.
+void hash_group(LaneKernel kernel, size_t lanes,
+                const std::array<uint32_t, 8>& init, uint64_t prefix,
+                const ByteView* in, Digest* out, const size_t* index, size_t count) {
+    uint32_t state[8 * 16];
+    Tail tails[16];
+    size_t blocks[16];
+    const uint8_t* ptrs[16];
+
+    size_t longest = 0;
+    for (size_t lane = 0; lane < lanes; lane++) {
+        const ByteView& msg = in[index[std::min(lane, count - 1)]];
+        make_tail(msg, prefix, tails[lane]);
+        blocks[lane] = padded_blocks(msg.size);
+        longest = std::max(longest, blocks[lane]);
+        for (int r = 0; r < 8; r++) {
+            state[r * lanes + lane] = init[r];
+        }
+    }
+
+    for (size_t blk = 0; blk < longest; blk++) {
+        for (size_t lane = 0; lane < lanes; lane++) {
+            const ByteView& msg = in[index[std::min(lane, count - 1)]];
+            size_t b = std::min(blk, blocks[lane] - 1);
+            if (b < tails[lane].full) {
+                ptrs[lane] = msg.data + b * 64;
+            } else {
+                ptrs[lane] = tails[lane].bytes + (b - tails[lane].full) * 64;
+            }
+        }
+
+        kernel(state, ptrs);
+
+        for (size_t lane = 0; lane < count; lane++) {
+            if (blk + 1 == blocks[lane]) {
+                store_digest(state, lanes, lane, out[index[lane]]);
+            }
+        }
+    }
+}
+
+} // namespace
+
+size_t sha256_batch_lanes() {
+    static size_t lanes = detect_lanes();
+    return lanes;
+}
+
+void sha256_batch(const ByteView* in, Digest* out, size_t count) {
+    sha256_batch_from(IV, 0, in, out, count);
+}
+
+void sha256_batch_from(const std::array<uint32_t, 8>& state, uint64_t prefix,
+                       const ByteView* in, Digest* out, size_t count) {
+    size_t lanes = sha256_batch_lanes();
+
+    if (lanes == 1) {
+        for (size_t i = 0; i < count; i++) {
+            Sha256Context ctx(state, prefix);
+            ctx.update(in[i].data, in[i].size);
+            ctx.final(out[i]);
+        }
+        return;
+    }
+
+    // Group messages of equal padded length so every lane does useful work
+    std::vector<size_t> order(count);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](size_t x, size_t y) {
+        return padded_blocks(in[x].size) < padded_blocks(in[y].size);
+    });
+
+    size_t i = 0;
+    while (i < count) {
+        // narrow down for the last few messages instead of wasting lanes
+        while (lanes > 4 && count - i <= lanes / 2) {
+            lanes /= 2;
+        }
+        size_t n = std::min(lanes, count - i);
+        hash_group(kernel_for(lanes), lanes, state, prefix, in, out, order.data() + i, n);
+        i += n;
+    }
+}
+
+// Hash256 of one header for consecutive nonces: every lane starts from the
+// shared midstate with its own nonce, then runs the one-block outer hash
+void sha256d_header_batch(const Sha256dHeader& header, uint32_t first_nonce,
+                          Digest* out, size_t count) {
+    size_t lanes = sha256_batch_lanes();
+    if (prefer_single_lane(lanes)) {
+        for (size_t i = 0; i < count; i++) {
+            header.hash(first_nonce + static_cast<uint32_t>(i), out[i]);
+        }
+        return;
+    }
+
+    LaneKernel kernel = kernel_for(lanes);
+    uint32_t state[8 * 16];
+    uint8_t blocks[16][64];
+    const uint8_t* ptrs[16];
+    for (size_t lane = 0; lane < lanes; lane++) {
+        ptrs[lane] = blocks[lane];
+    }
+
+    for (size_t done = 0; done < count; done += lanes) {
+        size_t n = std::min(lanes, count - done);
+
+        // inner hash, second block; surplus lanes just run ahead
+        for (size_t lane = 0; lane < lanes; lane++) {
+            uint32_t nonce = first_nonce + static_cast<uint32_t>(done + lane);
+            std::memcpy(blocks[lane], header.tail, 64);
+            blocks[lane][12] = static_cast<uint8_t>(nonce);
+            blocks[lane][13] = static_cast<uint8_t>(nonce >> 8);
+            blocks[lane][14] = static_cast<uint8_t>(nonce >> 16);
+            blocks[lane][15] = static_cast<uint8_t>(nonce >> 24);
+            for (int r = 0; r < 8; r++) {
+                state[r * lanes + lane] = header.midstate[r];
+            }
+        }
+        kernel(state, ptrs);
+
+        // outer hash: 32 digest bytes + fixed padding, from IV
+        for (size_t lane = 0; lane < lanes; lane++) {
+            Digest first;
+            store_digest(state, lanes, lane, first);
+            std::memcpy(blocks[lane], first.data(), 32);
+            std::memset(blocks[lane] + 32, 0, 32);
+            blocks[lane][32] = 0x80;
+            blocks[lane][62] = 0x01;   // 256 bits
+            for (int r = 0; r < 8; r++) {
+                state[r * lanes + lane] = IV[r];
+            }
+        }
+        kernel(state, ptrs);
+
+        for (size_t lane = 0; lane < n; lane++) {
+            store_digest(state, lanes, lane, out[done + lane]);
+        }
+    }
+}
+
+namespace {
+
+// Writes the state words big-endian over the first 32 bytes of a block
+void store_state(const std::array<uint32_t, 8>& state, uint8_t* block) {
+    for (int r = 0; r < 8; r++) {
+        block[r * 4 + 0] = static_cast<uint8_t>(state[r] >> 24);
+        block[r * 4 + 1] = static_cast<uint8_t>(state[r] >> 16);
+        block[r * 4 + 2] = static_cast<uint8_t>(state[r] >> 8);
+        block[r * 4 + 3] = static_cast<uint8_t>(state[r]);
+    }
+}
+
+// Scalar hmac_iterate(): same fixed padding block, one job at a time
+void hmac_iterate_one(const std::array<uint32_t, 8>& inner, const std::array<uint32_t, 8>& outer,
+                      Digest& u, Digest& t, uint32_t rounds) {
+    uint8_t block[64] = {0};
+    block[32] = 0x80;
+    block[62] = 0x03;   // 768 bits: key block + 32 bytes
+
+    std::copy(u.begin(), u.end(), block);
+    for (uint32_t it = 0; it < rounds; it++) {
+        std::array<uint32_t, 8> state = inner;
+        compress_blocks(state, block, 1);
+        store_state(state, block);
+
+        state = outer;
+        compress_blocks(state, block, 1);
+        store_state(state, block);
+
+        for (int i = 0; i < 32; i++) {
+            t[i] ^= block[i];
+        }
+    }
+    std::copy(block, block + 32, u.begin());
+}
+
+} // namespace
+
+void hmac_iterate_batch(const std::array<uint32_t, 8>* inner, const std::array<uint32_t, 8>* outer,
+                        Digest* u, Digest* t, size_t count, uint32_t rounds) {
+    size_t lanes = sha256_batch_lanes();
+    if (prefer_single_lane(lanes)) {
+        for (size_t i = 0; i < count; i++) {
+            hmac_iterate_one(inner[i], outer[i], u[i], t[i], rounds);
+        }
+        return;
+    }
+
+    uint32_t in[8 * 16], out[8 * 16], uu[8 * 16], tt[8 * 16];
+    for (size_t done = 0; done < count; done += lanes) {
+        // narrow down for the last few jobs instead of wasting lanes
+        while (lanes > 4 && count - done <= lanes / 2) {
+            lanes /= 2;
+        }
+        size_t n = std::min(lanes, count - done);
+        if (prefer_single_lane(lanes)) {
+            for (size_t j = done; j < done + n; j++) {
+                hmac_iterate_one(inner[j], outer[j], u[j], t[j], rounds);
+            }
+            continue;
+        }
+
+        // surplus lanes repeat the last job and are discarded
+        for (size_t lane = 0; lane < lanes; lane++) {
+            size_t j = done + std::min(lane, n - 1);
+            for (int r = 0; r < 8; r++) {
+                in[r * lanes + lane] = inner[j][r];
+                out[r * lanes + lane] = outer[j][r];
+                uu[r * lanes + lane] = load_word(u[j], r);
+                tt[r * lanes + lane] = load_word(t[j], r);
+            }
+        }
+
+        iterate_kernel_for(lanes)(in, out, uu, tt, rounds);
+
+        for (size_t lane = 0; lane < n; lane++) {
+            store_digest(uu, lanes, lane, u[done + lane]);
+            store_digest(tt, lanes, lane, t[done + lane]);
+        }
+    }
+}
@@ -0,0 +1,236 @@
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <new>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "SHA.h"
+
+// ============ Microbenchmarks ============
+// sha256_bench: times every primitive and sha256() over a range of message
+// sizes. Each case runs for at least ~0.2 s; reported per operation are
+// wall-clock ns, TSC cycles (per byte for sized cases, x86 only) and heap
+// allocations, counted by the operator new below.
+
+static std::atomic<uint64_t> g_allocations(0);
+
+void* operator new(size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    std::free(p);
+}
+
+namespace {
+
+// Keeps a result alive without the compiler seeing what is done with it
+template <typename T>
+inline void keep(const T& value) {
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+inline uint64_t cycles() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+struct BenchResult {
+    std::string name;
+    size_t bytes;    // message size, 0 for primitives
+    double ns;       // per op
+    double cycles;   // per op
+    double allocs;   // per op
+};
+
+const double kMinSeconds = 0.2;
+
+// Runs op() in growing batches until one batch takes kMinSeconds
+template <typename Op>
+BenchResult measure(const std::string& name, size_t bytes, Op op) {
+    uint64_t iterations = 1;
+    for (;;) {
+        uint64_t allocs = g_allocations.load();
+        uint64_t c0 = cycles();
+        auto t0 = std::chrono::steady_clock::now();
+        for (uint64_t i = 0; i < iterations; i++) {
+            op(i);
+        }
+        auto t1 = std::chrono::steady_clock::now();
+        uint64_t c1 = cycles();
+        allocs = g_allocations.load() - allocs;
+
+        double seconds = std::chrono::duration<double>(t1 - t0).count();
+        if (seconds >= kMinSeconds || iterations >= (uint64_t(1) << 40)) {
+            double n = static_cast<double>(iterations);
+            return {name, bytes, seconds * 1e9 / n, (c1 - c0) / n, allocs / n};
+        }
+        iterations = seconds > 0.01 ? static_cast<uint64_t>(iterations * kMinSeconds * 1.2 / seconds)
+                                    : iterations * 10;
+    }
+}
+
+// Digits with an optional K/M/G suffix; false on anything else or a size
+// that doesn't fit
+bool parse_bench_size(const std::string& text, size_t& size) {
+    if (text.empty() || text[0] < '0' || text[0] > '9') {
+        return false;   // strtoull would accept "-1" and wrap it
+    }
+    char* end = nullptr;
+    errno = 0;
+    unsigned long long n = std::strtoull(text.c_str(), &end, 10);
+    std::string suffix = end;
+    int shift = 0;
+    if (suffix == "K" || suffix == "k") shift = 10;
+    else if (suffix == "M" || suffix == "m") shift = 20;
+    else if (suffix == "G" || suffix == "g") shift = 30;
+    else if (!suffix.empty()) return false;
+    if (errno == ERANGE || n > (std::numeric_limits<size_t>::max() >> shift)) {
+        return false;
+    }
+    size = static_cast<size_t>(n) << shift;
+    return true;
+}
+
+int usage() {
+    std::cerr << "Usage: sha256_bench [--json] [--sizes 0,55,64,1K,1M,1G]" << std::endl;
+    return 2;
+}
+
+std::string size_label(size_t bytes) {
+    if (bytes >= (1 << 30) && bytes % (1 << 30) == 0) return std::to_string(bytes >> 30) + "GB";
+    if (bytes >= (1 << 20) && bytes % (1 << 20) == 0) return std::to_string(bytes >> 20) + "MB";
+    if (bytes >= (1 << 10) && bytes % (1 << 10) == 0) return std::to_string(bytes >> 10) + "KB";
+    return std::to_string(bytes) + "B";
+}
+
+void print_table(const std::vector<BenchResult>& results) {
+    std::printf("%-28s %14s %12s %10s\n", "benchmark", "ns/op", "cycles/B", "allocs/op");
+    for (const BenchResult& r : results) {
+        std::string per_byte = r.bytes > 0 && r.cycles > 0 ? std::to_string(r.cycles / r.bytes) : "-";
+        std::printf("%-28s %14.2f %12s %10.2f\n", r.name.c_str(), r.ns, per_byte.c_str(), r.allocs);
+    }
+}
+
+void print_json(const std::vector<BenchResult>& results) {
+    std::printf("{\n  \"backend\": \"%s\",\n  \"lanes\": %zu,\n  \"results\": [\n",
+                sha256_backend_name(sha256_get_backend()), sha256_batch_lanes());
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchResult& r = results[i];
+        double per_byte = r.bytes > 0 ? r.cycles / r.bytes : 0;
+        std::printf("    {\"name\": \"%s\", \"bytes\": %zu, \"ns_per_op\": %.3f, "
+                    "\"cycles_per_op\": %.1f, \"cycles_per_byte\": %.4f, \"allocs_per_op\": %.3f}%s\n",
+                    r.name.c_str(), r.bytes, r.ns, r.cycles, per_byte, r.allocs,
+                    i + 1 < results.size() ? "," : "");
+    }
+    std::printf("  ]\n}\n");
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    bool json = false;
+    std::vector<size_t> sizes = {0, 55, 64, 1 << 10, 1 << 20, size_t(1) << 30};
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--json") {
+            json = true;
+        } else if (arg == "--sizes" && i + 1 < argc) {
+            // comma-separated, e.g. 0,64,1K,1M
+            sizes.clear();
+            std::string list = argv[++i];
+            size_t start = 0;
+            while (start <= list.size()) {
+                size_t comma = std::min(list.find(',', start), list.size());
+                size_t size = 0;
+                if (!parse_bench_size(list.substr(start, comma - start), size)) {
+                    return usage();
+                }
+                sizes.push_back(size);
+                start = comma + 1;
+            }
+        } else {
+            return usage();
+        }
+    }
+
+    std::vector<BenchResult> results;
+
+    // Primitives: each result feeds the next call, so calls can't be
+    // hoisted out of the loop
+    uint32_t x = 0x6a09e667;
+    results.push_back(measure("rotr", 0, [&](uint64_t i) { x = rotr(static_cast<int>(i & 31) | 1, x) + 1; keep(x); }));
+    results.push_back(measure("sigma0", 0, [&](uint64_t) { x = sigma0(x) + 1; keep(x); }));
+    results.push_back(measure("sigma1", 0, [&](uint64_t) { x = sigma1(x) + 1; keep(x); }));
+    results.push_back(measure("usigma0", 0, [&](uint64_t) { x = usigma0(x) + 1; keep(x); }));
+    results.push_back(measure("usigma1", 0, [&](uint64_t) { x = usigma1(x) + 1; keep(x); }));
+    results.push_back(measure("ch", 0, [&](uint64_t i) { x = ch(x, static_cast<uint32_t>(i), ~x) + 1; keep(x); }));
+    results.push_back(measure("maj", 0, [&](uint64_t i) { x = maj(x, static_cast<uint32_t>(i), ~x) + 1; keep(x); }));
+
+    // One block through the schedule and compression, old and new APIs
+    uint8_t block[64];
+    for (int i = 0; i < 64; i++) {
+        block[i] = static_cast<uint8_t>(i * 13);
+    }
+    std::string bit_block = bitstring(std::string(reinterpret_cast<char*>(block), 64));
+    std::vector<uint32_t> iv(IV.begin(), IV.end());
+    std::vector<uint32_t> k(K.begin(), K.end());
+    std::vector<uint32_t> schedule = calculate_schedule(block);
+
+    results.push_back(measure("calculate_schedule(string)", 64, [&](uint64_t) {
+        keep(calculate_schedule(bit_block)); }));
+    results.push_back(measure("calculate_schedule(bytes)", 64, [&](uint64_t) {
+        keep(calculate_schedule(block)); }));
+    results.push_back(measure("compression", 64, [&](uint64_t) {
+        keep(compression(iv, schedule, k)); }));
+
+    std::array<uint32_t, 8> state;
+    std::copy(IV.begin(), IV.end(), state.begin());
+    results.push_back(measure("compress", 64, [&](uint64_t) { compress(state, block); keep(state); }));
+    results.push_back(measure("compress_blocks", 64, [&](uint64_t) {
+        compress_blocks(state, block, 1); keep(state); }));
+
+    // End to end
+    size_t largest = sizes.empty() ? 0 : *std::max_element(sizes.begin(), sizes.end());
+    std::vector<uint8_t> message(largest);
+    for (size_t i = 0; i < largest; i++) {
+        message[i] = static_cast<uint8_t>(i * 31 + 7);
+    }
+    for (size_t size : sizes) {
+        results.push_back(measure("sha256/" + size_label(size), size, [&](uint64_t) {
+            keep(sha256(message.data(), size)); }));
+        results.push_back(measure("sha256_digest/" + size_label(size), size, [&](uint64_t) {
+            keep(sha256_digest(message.data(), size)); }));
+    }
+
+    if (json) {
+        print_json(results);
+    } else {
+        std::printf("backend: %s, batch lanes: %zu\n",
+                    sha256_backend_name(sha256_get_backend()), sha256_batch_lanes());
+        print_table(results);
+    }
+    return 0;
+}
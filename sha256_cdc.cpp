@@ -0,0 +1,224 @@
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "SHA.h"
+
+// ============ Content-Defined Chunking ============
+// FastCDC-style cut points over a Gear rolling hash: fp = (fp << 1) + G[b],
+// so the top bits of fp depend on the last 64 bytes only. A cut is taken
+// where the masked top bits are all zero. Below the average size a mask
+// with two more bits is used, above it one with two fewer (normalised
+// chunking), which pulls chunk sizes towards the average.
+
+namespace {
+
+// Gear table: 256 pseudo-random words from splitmix64, built at compile
+// time so every build cuts at the same places
+constexpr std::array<uint64_t, 256> make_gear() {
+    std::array<uint64_t, 256> gear{};
+    uint64_t x = 0x5348412d32353621ULL;
+    for (int i = 0; i < 256; i++) {
+        x += 0x9e3779b97f4a7c15ULL;
+        uint64_t z = x;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        gear[i] = z ^ (z >> 31);
+    }
+    return gear;
+}
+
+constexpr std::array<uint64_t, 256> kGear = make_gear();
+
+// `bits` ones at the top of a 64-bit word
+uint64_t top_mask(int bits) {
+    return bits <= 0 ? 0 : ~uint64_t(0) << (64 - bits);
+}
+
+int log2_floor(size_t n) {
+    int bits = 0;
+    while (n >>= 1) bits++;
+    return bits;
+}
+
+} // namespace
+
+bool CdcParams::valid() const {
+    bool power_of_two = avg_size != 0 && (avg_size & (avg_size - 1)) == 0;
+    return min_size > 0 && min_size <= avg_size && avg_size <= max_size && power_of_two;
+}
+
+CdcChunker::CdcChunker(const CdcParams& params) : params(params) {
+    int bits = log2_floor(params.avg_size);
+    mask_small = top_mask(bits + 2);
+    mask_large = top_mask(bits - 2);
+}
+
+size_t CdcChunker::cut(const uint8_t* data, size_t size) const {
+    if (size <= params.min_size) {
+        return size;
+    }
+    size_t end = std::min(size, params.max_size);
+    size_t normal = std::min(end, params.avg_size);
+
+    uint64_t fp = 0;
+    size_t i = params.min_size;
+    for (; i < normal; i++) {
+        fp = (fp << 1) + kGear[data[i]];
+        if ((fp & mask_small) == 0) {
+            return i + 1;
+        }
+    }
+    for (; i < end; i++) {
+        fp = (fp << 1) + kGear[data[i]];
+        if ((fp & mask_large) == 0) {
+            return i + 1;
+        }
+    }
+    return end;
+}
+
+// ============ Chunk + Hash Pipeline ============
+// The calling thread reads and chunks the stream into segments of whole
+// chunks; worker threads hash each segment's chunks with sha256_batch().
+// Segments are reported in stream order, and at most a few are in flight
+// so memory stays bounded however long the stream is.
+
+namespace {
+
+const size_t kSegmentSize = size_t(8) << 20;
+
+struct Segment {
+    uint64_t offset;                // stream offset of data[0]
+    std::vector<uint8_t> data;
+    std::vector<size_t> lengths;    // chunk lengths, back to back
+    std::vector<Digest> digests;
+    bool done = false;
+};
+
+void hash_segment(Segment& seg) {
+    std::vector<ByteView> views(seg.lengths.size());
+    size_t pos = 0;
+    for (size_t i = 0; i < views.size(); i++) {
+        views[i] = {seg.data.data() + pos, seg.lengths[i]};
+        pos += seg.lengths[i];
+    }
+    seg.digests.resize(views.size());
+    sha256_batch(views.data(), seg.digests.data(), views.size());
+}
+
+} // namespace
+
+bool sha256_cdc(std::istream& in, const CdcParams& params, size_t threads,
+                const std::function<void(const ChunkRecord&)>& emit) {
+    if (!params.valid()) {
+        return false;
+    }
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    CdcChunker chunker(params);
+
+    std::mutex lock;
+    std::condition_variable changed;
+    std::deque<std::shared_ptr<Segment>> queue;      // waiting to be hashed
+    std::deque<std::shared_ptr<Segment>> in_flight;  // not yet reported
+    bool finished = false;
+    const size_t max_in_flight = threads * 2 + 2;
+
+    auto worker = [&]() {
+        std::unique_lock<std::mutex> guard(lock);
+        for (;;) {
+            changed.wait(guard, [&] { return !queue.empty() || finished; });
+            if (queue.empty()) {
+                return;
+            }
+            std::shared_ptr<Segment> seg = queue.front();
+            queue.pop_front();
+
+            guard.unlock();
+            hash_segment(*seg);
+            guard.lock();
+
+            // report every finished segment at the front, in order
+            seg->done = true;
+            while (!in_flight.empty() && in_flight.front()->done) {
+                const Segment& ready = *in_flight.front();
+                uint64_t offset = ready.offset;
+                for (size_t i = 0; i < ready.lengths.size(); i++) {
+                    emit({offset, ready.lengths[i], ready.digests[i]});
+                    offset += ready.lengths[i];
+                }
+                in_flight.pop_front();
+            }
+            changed.notify_all();
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (size_t t = 0; t < threads; t++) {
+        pool.emplace_back(worker);
+    }
+
+    // bytes read but not yet cut (less than max_size unless at EOF)
+    std::vector<uint8_t> pending;
+    uint64_t offset = 0;
+    bool eof = false;
+    while (!eof) {
+        size_t have = pending.size();
+        pending.resize(have + kSegmentSize);
+        in.read(reinterpret_cast<char*>(pending.data() + have), kSegmentSize);
+        pending.resize(have + static_cast<size_t>(in.gcount()));
+        eof = !in;
+
+        auto seg = std::make_shared<Segment>();
+        seg->offset = offset;
+        size_t pos = 0;
+        // mid-stream, only cut where a full max_size window is available,
+        // so a boundary never depends on where a read happened to end
+        while (pos < pending.size() && (eof || pending.size() - pos >= params.max_size)) {
+            size_t len = chunker.cut(pending.data() + pos, pending.size() - pos);
+            seg->lengths.push_back(len);
+            pos += len;
+        }
+        seg->data.assign(pending.begin(), pending.begin() + pos);
+        pending.erase(pending.begin(), pending.begin() + pos);
+        offset += pos;
+
+        if (seg->lengths.empty()) {
+            continue;
+        }
+        std::unique_lock<std::mutex> guard(lock);
+        changed.wait(guard, [&] { return in_flight.size() < max_in_flight; });
+        queue.push_back(seg);
+        in_flight.push_back(seg);
+        changed.notify_all();
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        finished = true;
+    }
+    changed.notify_all();
+    for (std::thread& t : pool) {
+        t.join();
+    }
+    return !in.bad();
+}
+
+bool sha256_cdc_file(const std::string& path, const CdcParams& params, size_t threads,
+                     const std::function<void(const ChunkRecord&)>& emit) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    return sha256_cdc(file, params, threads, emit);
+}
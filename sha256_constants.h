@@ -0,0 +1,89 @@
+#ifndef SHA256_CONSTANTS_H
+#define SHA256_CONSTANTS_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// ============ Compile-Time Derivation ============
+// Same definition as before (first 32 bits of the fractional part of a root
+// of a prime), but done with exact integer roots so the tables are constexpr
+// and end up in read-only data instead of being computed at startup.
+
+namespace sha256_constants {
+
+using u128 = unsigned __int128;
+
+constexpr int primes[64] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53,
+                            59, 61, 67, 71, 73, 79, 83, 89, 97, 101, 103, 107, 109, 113,
+                            127, 131, 137, 139, 149, 151, 157, 163, 167, 173, 179, 181,
+                            191, 193, 197, 199, 211, 223, 227, 229, 233, 239, 241, 251,
+                            257, 263, 269, 271, 277, 281, 283, 293, 307, 311};
+
+// Largest x with x^root <= n (binary search)
+constexpr uint64_t iroot(u128 n, int root) {
+    uint64_t lo = 0;
+    uint64_t hi = uint64_t(1) << 40;
+    while (lo < hi) {
+        uint64_t mid = lo + (hi - lo + 1) / 2;
+        u128 p = 1;
+        for (int i = 0; i < root; i++) p *= mid;
+        if (p <= n) lo = mid;
+        else hi = mid - 1;
+    }
+    return lo;
+}
+
+// floor(root(p) * 2^32) mod 2^32, i.e. the fractional part scaled to 32 bits
+constexpr uint32_t fraction(int prime, int root) {
+    return static_cast<uint32_t>(iroot(u128(prime) << (32 * root), root));
+}
+
+constexpr std::array<uint32_t, 64> make_k() {
+    std::array<uint32_t, 64> k{};
+    for (int i = 0; i < 64; i++) k[i] = fraction(primes[i], 3);
+    return k;
+}
+
+constexpr std::array<uint32_t, 8> make_iv() {
+    std::array<uint32_t, 8> iv{};
+    for (int i = 0; i < 8; i++) iv[i] = fraction(primes[i], 2);
+    return iv;
+}
+
+// std::array's operator== is only constexpr from C++20
+template <size_t N>
+constexpr bool equal(const std::array<uint32_t, N>& a, const std::array<uint32_t, N>& b) {
+    for (size_t i = 0; i < N; i++) {
+        if (a[i] != b[i]) return false;
+    }
+    return true;
+}
+
+} // namespace sha256_constants
+
+// ============ Constants ============
+
+// Constants = Cube roots of the first 64 prime numbers (first 32 bits of the fractional part)
+inline constexpr std::array<uint32_t, 64> K = sha256_constants::make_k();
+
+// Initial Hash Values = Square roots of the first 8 prime numbers (first 32 bits of the fractional part)
+inline constexpr std::array<uint32_t, 8> IV = sha256_constants::make_iv();
+
+// Cross-check against the tables published in FIPS 180-4, section 4.2.2 / 5.3.3
+static_assert(sha256_constants::equal(K, std::array<uint32_t, 64>{
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2}),
+    "K does not match FIPS 180-4");
+
+static_assert(sha256_constants::equal(IV, std::array<uint32_t, 8>{
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19}),
+    "IV does not match FIPS 180-4");
+
+#endif // SHA256_CONSTANTS_H
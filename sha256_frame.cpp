@@ -0,0 +1,320 @@
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/ioctl.h>
+#include <unistd.h>
+#define SHA256_FRAME_TTY 1
+#endif
+
+#include "SHA.h"
+
+// ============ Frame Renderer ============
+// The composed text is laid out on a grid of cells the size of the
+// terminal, wrapping long lines where the terminal would. Each present()
+// compares the grid with the previous one and emits a cursor move plus the
+// changed cells for every run of differences; short unchanged gaps inside
+// a run are rewritten rather than paying for another cursor move. All
+// glyphs are taken to be one column wide, which holds for the box, arrow
+// and Greek characters the animations use.
+
+namespace {
+
+const char* const kClear = "\033[2J\033[1;1H";
+const size_t kGapRewrite = 6;   // unchanged cells worth rewriting to avoid a move
+
+void move_to(std::string& out, size_t row, size_t col) {
+    out += "\033[";
+    out += std::to_string(row + 1);
+    out += ';';
+    out += std::to_string(col + 1);
+    out += 'H';
+}
+
+size_t utf8_length(unsigned char lead) {
+    if (lead < 0x80) return 1;
+    if ((lead >> 5) == 0x6) return 2;
+    if ((lead >> 4) == 0xE) return 3;
+    if ((lead >> 3) == 0x1E) return 4;
+    return 1;   // stray continuation byte, pass it through alone
+}
+
+bool terminal_size(int fd, int& width, int& height) {
+#ifdef SHA256_FRAME_TTY
+    struct winsize ws;
+    if (ioctl(fd, TIOCGWINSZ, &ws) == 0 && ws.ws_col > 0 && ws.ws_row > 0) {
+        width = ws.ws_col;
+        height = ws.ws_row;
+        return true;
+    }
+#else
+    (void)fd;
+#endif
+    return false;
+}
+
+} // namespace
+
+FrameRenderer::FrameRenderer(int fd)
+    : fd(fd), tty(false), dirty(true), saved(nullptr), sent(0), written(0),
+      drawn_width(0), drawn_height(0) {
+#ifdef SHA256_FRAME_TTY
+    tty = isatty(fd) != 0;
+#endif
+}
+
+FrameRenderer::~FrameRenderer() {
+    detach();
+}
+
+void FrameRenderer::attach() {
+    if (attached()) return;
+    std::cout.flush();
+    saved = std::cout.rdbuf(&back);
+    back.str(std::string());
+    sent = 0;
+    dirty = true;
+    if (tty) write_all("\033[?25l");   // hide the cursor while animating
+}
+
+void FrameRenderer::detach() {
+    if (!attached()) return;
+    present();
+    std::cout.rdbuf(saved);
+    saved = nullptr;
+    if (tty) write_all("\033[0m\033[?25h");
+}
+
+void FrameRenderer::begin() {
+    // Without a terminal to diff against, behave like the old clearScreen():
+    // the rest of the previous frame, then the clear sequence
+    if (!tty && attached()) {
+        present();
+        write_all(kClear);
+    }
+    back.str(std::string());
+    sent = 0;
+}
+
+void FrameRenderer::invalidate() {
+    dirty = true;
+}
+
+void FrameRenderer::layout(const std::string& text, int width, Grid& grid) const {
+    grid.clear();
+    std::vector<Cell> row;
+    std::string style;
+
+    size_t i = 0;
+    while (i < text.size()) {
+        unsigned char c = text[i];
+
+        if (c == '\n') {
+            grid.push_back(std::move(row));
+            row.clear();
+            i++;
+            continue;
+        }
+
+        if (c == '\033') {
+            if (i + 1 < text.size() && text[i + 1] == '[') {
+                size_t j = i + 2;
+                while (j < text.size() && (text[j] < 0x40 || text[j] > 0x7E)) j++;
+                if (j == text.size()) break;
+                std::string params = text.substr(i + 2, j - i - 2);
+                if (text[j] == 'm') {
+                    if (params.empty() || params == "0") style.clear();
+                    else style += text.substr(i, j - i + 1);
+                } else if (text[j] == 'J' && params == "2") {
+                    // a raw clear inside the frame drops what came before it
+                    grid.clear();
+                    row.clear();
+                }
+                i = j + 1;
+            } else {
+                i += 2;
+            }
+            continue;
+        }
+
+        if (c == '\t') {
+            size_t stop = (row.size() / 8 + 1) * 8;
+            while (row.size() < stop && static_cast<int>(row.size()) < width) {
+                row.push_back(Cell{" ", style});
+            }
+            i++;
+            continue;
+        }
+
+        if (c < 0x20) {   // \r and other controls have no cell
+            i++;
+            continue;
+        }
+
+        if (static_cast<int>(row.size()) == width) {
+            grid.push_back(std::move(row));
+            row.clear();
+        }
+
+        size_t length = std::min(utf8_length(c), text.size() - i);
+        row.push_back(Cell{text.substr(i, length), style});
+        i += length;
+    }
+
+    if (!row.empty()) grid.push_back(std::move(row));
+}
+
+void FrameRenderer::present() {
+    std::string text = back.str();
+
+    if (!tty) {
+        if (text.size() > sent) {
+            write_all(text.substr(sent));
+            written = text.size() - sent;
+            sent = text.size();
+        } else {
+            written = 0;
+        }
+        return;
+    }
+
+    draw(text);
+}
+
+void FrameRenderer::show(const std::string& text) {
+    if (tty) draw(text);
+}
+
+void FrameRenderer::size(int& width, int& height) const {
+    width = 80;
+    height = 24;
+    terminal_size(fd, width, height);
+}
+
+void FrameRenderer::draw(const std::string& text) {
+    int width, height;
+    size(width, height);
+
+    // After a resize the terminal has rewrapped or cut what it showed, so
+    // front no longer describes the screen
+    if (width != drawn_width || height != drawn_height) {
+        invalidate();
+        drawn_width = width;
+        drawn_height = height;
+    }
+
+    Grid grid;
+    layout(text, width, grid);
+
+    std::string out;
+    std::string style;   // SGR state the terminal is in
+
+    auto emit = [&](const Cell& cell) {
+        if (cell.style != style) {
+            out += "\033[0m";
+            out += cell.style;
+            style = cell.style;
+        }
+        out += cell.glyph;
+    };
+
+    if (static_cast<int>(grid.size()) > height) {
+        // Taller than the screen: rows scroll out of reach of cursor moves,
+        // so send the whole frame and diff from scratch next time
+        out += "\033[0m";
+        out += kClear;
+        for (size_t r = 0; r < grid.size(); r++) {
+            if (r > 0) out += "\r\n";
+            for (const Cell& cell : grid[r]) emit(cell);
+        }
+        out += "\033[0m";
+        write_all(out);
+        written = out.size();
+        front.clear();
+        dirty = true;
+        return;
+    }
+
+    if (dirty) {
+        out += "\033[0m\033[2J";
+        front.clear();
+    }
+
+    static const std::vector<Cell> kEmpty;
+    size_t rows = std::max(grid.size(), front.size());
+    for (size_t r = 0; r < rows; r++) {
+        const std::vector<Cell>& now = r < grid.size() ? grid[r] : kEmpty;
+        const std::vector<Cell>& was = r < front.size() ? front[r] : kEmpty;
+
+        size_t c = 0;
+        while (c < now.size()) {
+            if (c < was.size() && now[c] == was[c]) {
+                c++;
+                continue;
+            }
+
+            size_t end = c + 1, same = 0;
+            for (size_t k = c + 1; k < now.size(); k++) {
+                if (k < was.size() && now[k] == was[k]) {
+                    if (++same > kGapRewrite) break;
+                } else {
+                    same = 0;
+                    end = k + 1;
+                }
+            }
+
+            move_to(out, r, c);
+            for (size_t k = c; k < end; k++) emit(now[k]);
+            c = end;
+        }
+
+        if (was.size() > now.size()) {
+            move_to(out, r, now.size());
+            out += "\033[0m\033[K";
+            style.clear();
+        }
+    }
+
+    if (!out.empty()) {
+        // leave the cursor below the frame with default colours, so output
+        // after detach() starts on a clean line
+        if (!style.empty()) out += "\033[0m";
+        move_to(out, std::min(grid.size(), static_cast<size_t>(height - 1)), 0);
+        write_all(out);
+    }
+
+    written = out.size();
+    front = std::move(grid);
+    dirty = false;
+}
+
+void FrameRenderer::write_all(const std::string& data) {
+#ifdef SHA256_FRAME_TTY
+    const char* p = data.data();
+    size_t left = data.size();
+    while (left > 0) {
+        ssize_t n = ::write(fd, p, left);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return;
+        }
+        p += n;
+        left -= static_cast<size_t>(n);
+    }
+#else
+    // no raw descriptors: hand the bytes to the stream std::cout had
+    std::streambuf* target = saved ? saved : std::cout.rdbuf();
+    target->sputn(data.data(), data.size());
+    target->pubsync();
+#endif
+}
+
+FrameRenderer& frame_renderer() {
+    static FrameRenderer renderer(1);
+    return renderer;
+}
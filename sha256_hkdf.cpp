@@ -0,0 +1,68 @@
+#include <algorithm>
+#include <cstdint>
+
+#include "SHA.h"
+
+// ============ HKDF-SHA256 ============
+// RFC 5869. Extract: PRK = HMAC(salt, IKM). Expand:
+// T(i) = HMAC(PRK, T(i-1) || info || i), output = T(1) || T(2) || ...
+// The PRK's keyed states are built once, and each T(i) is streamed through
+// a Sha256Context resumed from them, so nothing is allocated.
+
+void hkdf_sha256_extract(const uint8_t* salt, size_t salt_length,
+                         const uint8_t* ikm, size_t ikm_length, Digest& prk) {
+    // No salt means a string of HashLen zeros, which keys HMAC the same
+    // way as an empty key
+    HmacSha256 hmac(salt, salt == nullptr ? 0 : salt_length);
+    hmac.mac(ikm, ikm_length, prk);
+}
+
+HkdfSha256::HkdfSha256(const Digest& prk) : hmac(prk.data(), prk.size()) {
+}
+
+HkdfSha256::HkdfSha256(const uint8_t* salt, size_t salt_length,
+                       const uint8_t* ikm, size_t ikm_length)
+    : HkdfSha256(extract(salt, salt_length, ikm, ikm_length)) {
+}
+
+Digest HkdfSha256::extract(const uint8_t* salt, size_t salt_length,
+                           const uint8_t* ikm, size_t ikm_length) {
+    Digest prk;
+    hkdf_sha256_extract(salt, salt_length, ikm, ikm_length, prk);
+    return prk;
+}
+
+bool HkdfSha256::expand(const uint8_t* info, size_t info_length,
+                        uint8_t* out, size_t out_length) const {
+    if (out_length > 255 * 32) {
+        return false;
+    }
+
+    Digest block;
+    for (size_t done = 0, i = 1; done < out_length; done += 32, i++) {
+        uint8_t counter = static_cast<uint8_t>(i);
+
+        Sha256Context inner(hmac.inner_state(), 64);
+        if (i > 1) {
+            inner.update(block.data(), block.size());
+        }
+        inner.update(info, info_length);
+        inner.update(&counter, 1);
+        inner.final(block);
+
+        Sha256Context outer(hmac.outer_state(), 64);
+        outer.update(block.data(), block.size());
+        outer.final(block);
+
+        size_t n = std::min<size_t>(32, out_length - done);
+        std::copy(block.begin(), block.begin() + n, out + done);
+    }
+    return true;
+}
+
+bool hkdf_sha256(const uint8_t* salt, size_t salt_length,
+                 const uint8_t* ikm, size_t ikm_length,
+                 const uint8_t* info, size_t info_length,
+                 uint8_t* out, size_t out_length) {
+    return HkdfSha256(salt, salt_length, ikm, ikm_length).expand(info, info_length, out, out_length);
+}
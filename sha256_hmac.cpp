@@ -0,0 +1,86 @@
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "SHA.h"
+
+// ============ HMAC-SHA256 ============
+// HMAC(K, m) = H((K ^ opad) || H((K ^ ipad) || m)). Both keyed blocks are
+// compressed in the constructor; a MAC then resumes from those states.
+
+namespace {
+
+// Chaining state after compressing one 64-byte key block XORed with pad
+std::array<uint32_t, 8> keyed_state(const uint8_t* key, uint8_t pad) {
+    uint8_t block[64];
+    for (int i = 0; i < 64; i++) {
+        block[i] = key[i] ^ pad;
+    }
+    std::array<uint32_t, 8> state;
+    std::copy(IV.begin(), IV.end(), state.begin());
+    compress_blocks(state, block, 1);
+    return state;
+}
+
+} // namespace
+
+HmacSha256::HmacSha256(const uint8_t* key, size_t key_length) {
+    // Keys longer than a block are hashed first; shorter ones zero-padded
+    uint8_t block[64] = {0};
+    if (key_length > 64) {
+        Digest digest = sha256_digest(key, key_length);
+        std::copy(digest.begin(), digest.end(), block);
+    } else {
+        std::copy(key, key + key_length, block);
+    }
+    inner = keyed_state(block, 0x36);
+    outer = keyed_state(block, 0x5c);
+}
+
+HmacSha256::HmacSha256(const std::string& key)
+    : HmacSha256(reinterpret_cast<const uint8_t*>(key.data()), key.size()) {
+}
+
+void HmacSha256::mac(const uint8_t* data, size_t length, Digest& out) const {
+    Sha256Context ctx(inner, 64);
+    ctx.update(data, length);
+    Digest digest;
+    ctx.final(digest);
+
+    Sha256Context outer_ctx(outer, 64);
+    outer_ctx.update(digest.data(), digest.size());
+    outer_ctx.final(out);
+}
+
+Digest HmacSha256::mac(const std::string& message) const {
+    Digest out;
+    mac(reinterpret_cast<const uint8_t*>(message.data()), message.size(), out);
+    return out;
+}
+
+void HmacSha256::mac_batch(const ByteView* in, Digest* out, size_t count) const {
+    std::vector<Digest> digests(count);
+    sha256_batch_from(inner, 64, in, digests.data(), count);
+
+    std::vector<ByteView> views(count);
+    for (size_t i = 0; i < count; i++) {
+        views[i] = {digests[i].data(), digests[i].size()};
+    }
+    sha256_batch_from(outer, 64, views.data(), out, count);
+}
+
+bool HmacSha256::verify(const uint8_t* data, size_t length, const Digest& expected) const {
+    Digest actual;
+    mac(data, length, actual);
+    return digest_equal_ct(actual, expected);
+}
+
+// No early exit, so the time taken doesn't reveal where tags differ
+bool digest_equal_ct(const Digest& a, const Digest& b) {
+    uint8_t diff = 0;
+    for (size_t i = 0; i < a.size(); i++) {
+        diff |= a[i] ^ b[i];
+    }
+    return diff == 0;
+}
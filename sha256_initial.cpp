@@ -7,34 +7,10 @@
 #include <thread>
 #include <chrono>
 
-// ============ Global Variables ============
-extern std::string g_delay;
-extern std::string g_state; // This would be defined elsewhere if needed
-
-// ============ Utility Functions ============
-
-void clearScreen() {
-    std::cout << "\033[2J\033[1;1H";
-}
-
-void delay(const std::string& speed) {
-    // This would use the same delay logic from sha256lib
-    // Simplified version here
-    int sleepTime = 400; // default normal
-    
-    if (speed == "fastest") sleepTime = 100;
-    else if (speed == "fast") sleepTime = 200;
-    else if (speed == "normal") sleepTime = 400;
-    else if (speed == "slow") sleepTime = 600;
-    else if (speed == "slowest") sleepTime = 800;
-    else if (speed == "end") sleepTime = 1000;
-    
-    std::this_thread::sleep_for(std::chrono::milliseconds(sleepTime));
-}
+#include "SHA.h"
 
-std::string bits(uint32_t x) {
-    return std::bitset<32>(x).to_string();
-}
+// ============ Global Variables ============
+std::string g_state;
 
 // ============ Main Visualization ============
 
@@ -10,34 +10,11 @@
 #include <thread>
 #include <chrono>
 
+#include "SHA.h"
+
 // ============ Global Variables ============
-extern std::string g_delay;
 extern std::string g_state;
 
-// ============ Utility Functions ============
-void clearScreen() {
-    std::cout << "\033[2J\033[1;1H";
-}
-
-void delay(const std::string& speed) {
-    // This would be the full delay implementation from sha256lib
-    // For now, a simplified version
-    int sleepTime = 400; // default normal
-    
-    if (speed == "fastest") sleepTime = 100;
-    else if (speed == "fast") sleepTime = 200;
-    else if (speed == "normal") sleepTime = 400;
-    else if (speed == "slow") sleepTime = 600;
-    else if (speed == "slowest") sleepTime = 800;
-    else if (speed == "end") sleepTime = 1000;
-    
-    std::this_thread::sleep_for(std::chrono::milliseconds(sleepTime));
-}
-
-std::string bits(uint32_t x) {
-    return std::bitset<32>(x).to_string();
-}
-
 // ============ Initial Hash Values ============
 
 // Calculate the initial hash values (H0-H7)
@@ -55,10 +32,7 @@ inline std::vector<uint32_t> calculateInitialHashValues() {
     return initial;
 }
 
-// The actual IV constants used in SHA-256
-const std::vector<uint32_t> IV = calculateInitialHashValues();
-
-// For reference, the standard SHA-256 IV values are:
+// These match the library's IV table:
 // H0 = 0x6a09e667
 // H1 = 0xbb67ae85
 // H2 = 0x3c6ef372
@@ -70,7 +44,7 @@ const std::vector<uint32_t> IV = calculateInitialHashValues();
 
 // ============ Visualization ============
 
-void showInitialHashValues() {
+inline void showInitialHashValues() {
     int primes[] = {2, 3, 5, 7, 11, 13, 17, 19};
     std::string registers[] = {"a", "b", "c", "d", "e", "f", "g", "h"};
     std::string indent = "  ";
@@ -0,0 +1,138 @@
+#include <algorithm>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "SHA.h"
+
+// ============ Merkle Trees ============
+// Bitcoin-style: parent = sha256d(left || right), and an odd level repeats
+// its last node. Each level is hashed with the multi-buffer kernel, in
+// slices; big levels are split across threads.
+
+static_assert(sizeof(Digest) == 32, "Digest arrays must be packed node-by-node");
+
+namespace {
+
+const size_t kSlice = 1024;             // pairs per batch call
+const size_t kParallelPairs = 1 << 14;  // smaller levels stay on one thread
+
+// parents[i] = sha256d(level[2i] || level[2i+1]); the two children are
+// adjacent in memory, so each pair is hashed in place as one 64-byte view
+void hash_pairs(const Digest* level, Digest* parents, size_t pairs) {
+    ByteView views[kSlice];
+    Digest inner[kSlice];
+
+    for (size_t done = 0; done < pairs; done += kSlice) {
+        size_t n = std::min(kSlice, pairs - done);
+        for (size_t i = 0; i < n; i++) {
+            views[i] = {level[2 * (done + i)].data(), 64};
+        }
+        sha256_batch(views, inner, n);
+
+        for (size_t i = 0; i < n; i++) {
+            views[i] = {inner[i].data(), 32};
+        }
+        sha256_batch(views, parents + done, n);
+    }
+}
+
+void hash_level(const Digest* level, Digest* parents, size_t pairs, size_t threads) {
+    if (threads <= 1 || pairs < kParallelPairs) {
+        hash_pairs(level, parents, pairs);
+        return;
+    }
+
+    size_t per = (pairs + threads - 1) / threads;
+    std::vector<std::thread> pool;
+    for (size_t begin = per; begin < pairs; begin += per) {
+        size_t n = std::min(per, pairs - begin);
+        pool.emplace_back(hash_pairs, level + 2 * begin, parents + begin, n);
+    }
+    hash_pairs(level, parents, std::min(per, pairs));
+    for (std::thread& t : pool) {
+        t.join();
+    }
+}
+
+// Repeat the last node of an odd level (not of the root)
+void pad_level(std::vector<Digest>& level) {
+    if (level.size() > 1 && level.size() % 2 == 1) {
+        level.push_back(level.back());
+    }
+}
+
+size_t default_threads(size_t threads) {
+    return threads != 0 ? threads : std::max(1u, std::thread::hardware_concurrency());
+}
+
+} // namespace
+
+Digest merkle_root(const Digest* leaves, size_t count, size_t threads) {
+    if (count == 0) {
+        return Digest{};
+    }
+    threads = default_threads(threads);
+
+    // Only the current level is kept
+    std::vector<Digest> level(leaves, leaves + count);
+    while (level.size() > 1) {
+        pad_level(level);
+        size_t pairs = level.size() / 2;
+        std::vector<Digest> parents(pairs);
+        hash_level(level.data(), parents.data(), pairs, threads);
+        level.swap(parents);
+    }
+    return level[0];
+}
+
+MerkleTree::MerkleTree(const Digest* leaves, size_t count, size_t threads)
+    : leaf_count(count) {
+    if (count == 0) {
+        levels.push_back({Digest{}});
+        return;
+    }
+    threads = default_threads(threads);
+
+    levels.emplace_back(leaves, leaves + count);
+    while (levels.back().size() > 1) {
+        pad_level(levels.back());
+        const std::vector<Digest>& below = levels.back();
+        size_t pairs = below.size() / 2;
+        std::vector<Digest> parents(pairs);
+        hash_level(below.data(), parents.data(), pairs, threads);
+        levels.push_back(std::move(parents));
+    }
+}
+
+const Digest& MerkleTree::root() const {
+    return levels.back()[0];
+}
+
+std::vector<Digest> MerkleTree::proof(size_t index) const {
+    std::vector<Digest> siblings;
+    // levels[0] may hold a repeated last leaf, so check the real count
+    if (index >= leaf_count) {
+        return siblings;
+    }
+    for (size_t depth = 0; depth + 1 < levels.size(); depth++) {
+        siblings.push_back(levels[depth][index ^ 1]);
+        index /= 2;
+    }
+    return siblings;
+}
+
+bool merkle_verify(const Digest& leaf, size_t index, const std::vector<Digest>& proof,
+                   const Digest& root) {
+    Digest node = leaf;
+    uint8_t pair[64];
+    for (const Digest& sibling : proof) {
+        const Digest& left = (index & 1) ? sibling : node;
+        const Digest& right = (index & 1) ? node : sibling;
+        std::copy(left.begin(), left.end(), pair);
+        std::copy(right.begin(), right.end(), pair + 32);
+        node = sha256d(pair, 64);
+        index /= 2;
+    }
+    return node == root;
+}
@@ -0,0 +1,113 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "SHA.h"
+
+// ============ Proof-of-Work Search ============
+// Workers pull fixed-size nonce ranges from a shared counter and hash each
+// range with the multi-buffer header kernel. Every worker keeps its own
+// copy of the midstate so nothing is shared on the hot path.
+
+namespace {
+
+const uint64_t kRange = 1 << 16;   // nonces claimed per worker at a time
+const size_t kGroup = 256;         // nonces hashed per batch call
+
+// Hash256 is compared as a little-endian 256-bit number, so the last
+// digest byte is the most significant
+bool meets_target(const Digest& hash, const Digest& target) {
+    for (int i = 0; i < 32; i++) {
+        uint8_t h = hash[31 - i];
+        if (h != target[i]) {
+            return h < target[i];
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+Digest target_from_bits(uint32_t bits) {
+    Digest target = {};
+    int exponent = static_cast<int>(bits >> 24);
+    uint32_t mantissa = bits & 0x007FFFFF;
+
+    // target = mantissa * 256^(exponent - 3), written big-endian
+    for (int i = 0; i < 3; i++) {
+        int pos = 32 - exponent + i;
+        if (pos >= 0 && pos < 32) {
+            target[pos] = static_cast<uint8_t>(mantissa >> (16 - 8 * i));
+        }
+    }
+    return target;
+}
+
+MineResult sha256d_mine(const uint8_t* header, const Digest& target, size_t threads,
+                        uint32_t first_nonce, uint64_t max_nonces) {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    max_nonces = std::min(max_nonces, uint64_t(1) << 32);
+
+    MineResult result = {};
+    std::mutex result_lock;
+    std::atomic<uint64_t> next(0);
+    std::atomic<uint64_t> hashes(0);
+    std::atomic<bool> stop(false);
+
+    auto worker = [&]() {
+        Sha256dHeader midstate(header);
+        Digest digests[kGroup];
+        uint64_t tried = 0;
+
+        while (!stop.load(std::memory_order_relaxed)) {
+            uint64_t begin = next.fetch_add(kRange);
+            if (begin >= max_nonces) {
+                break;
+            }
+            uint64_t end = std::min(begin + kRange, max_nonces);
+
+            for (uint64_t i = begin; i < end && !stop.load(std::memory_order_relaxed); i += kGroup) {
+                size_t n = static_cast<size_t>(std::min<uint64_t>(kGroup, end - i));
+                uint32_t nonce = first_nonce + static_cast<uint32_t>(i);
+                sha256d_header_batch(midstate, nonce, digests, n);
+                tried += n;
+
+                for (size_t k = 0; k < n; k++) {
+                    if (!meets_target(digests[k], target)) {
+                        continue;
+                    }
+                    std::lock_guard<std::mutex> guard(result_lock);
+                    if (!result.found) {
+                        result.found = true;
+                        result.nonce = nonce + static_cast<uint32_t>(k);
+                        result.hash = digests[k];
+                    }
+                    stop = true;
+                    break;
+                }
+            }
+        }
+        hashes += tried;
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> pool;
+    for (size_t t = 1; t < threads; t++) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& t : pool) {
+        t.join();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    result.hashes = hashes;
+    result.seconds = elapsed.count();
+    return result;
+}
@@ -0,0 +1,150 @@
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "SHA.h"
+
+// ============ Level-of-Detail Views ============
+// A 1 MB message is 16K blocks and a million rounds; its bits alone would
+// fill thousands of screens. The trace counts the register bits every
+// block flips while it records, so the overview only reads the counts: a
+// block map costs one pass over them and never touches more screen cells
+// than it is given, and only the selected block's rounds are needed.
+
+namespace {
+
+// Five shades, all one column wide; "·" keeps quiet blocks visible
+const char* const kShades[] = {"·", "░", "▒", "▓", "█"};
+const int kLevels = 5;
+
+std::array<uint32_t, 8> registers(const Sha256Trace& trace, size_t block, int round) {
+    if (round < 0) return trace.state_before(block);
+    return trace.round(block, round).reg;
+}
+
+uint32_t flipped(uint32_t before, uint32_t after) {
+    return static_cast<uint32_t>(std::bitset<32>(before ^ after).count());
+}
+
+} // namespace
+
+bool overview_needed(uint64_t length) {
+    int width, height;
+    frame_renderer().size(width, height);
+    uint64_t padded_bits = padded_blocks(length) * 512;
+    return padded_bits > static_cast<uint64_t>(width) * static_cast<uint64_t>(height);
+}
+
+std::string elide(const std::string& text, size_t width) {
+    return elide(text, text, text.size(), width);
+}
+
+std::string elide(const std::string& head, const std::string& tail, uint64_t total, size_t width) {
+    if (total <= width) return head.substr(0, total);
+
+    // Sized with the whole length, which has at least as many digits as
+    // the count actually cut
+    std::string marker = "...[" + std::to_string(total) + " more]...";
+    if (width <= marker.size()) return head.substr(0, width);
+
+    size_t keep = width - marker.size();
+    size_t front = (keep + 1) / 2;
+    size_t back = std::min(keep - front, tail.size());
+    marker = "...[" + std::to_string(total - front - back) + " more]...";
+    return head.substr(0, front) + marker + tail.substr(tail.size() - back);
+}
+
+std::string padded_bits(const uint8_t* data, uint64_t length, uint64_t first, uint64_t count) {
+    uint64_t message_bits = length * 8;
+    uint64_t total = padded_blocks(length) * 512;
+    uint64_t last = std::min(first + count, total);
+
+    std::string out;
+    out.reserve(static_cast<size_t>(last > first ? last - first : 0));
+    for (uint64_t p = first; p < last; p++) {
+        bool bit;
+        if (p < message_bits) bit = (data[p / 8] >> (7 - p % 8)) & 1;
+        else if (p == message_bits) bit = true;
+        else if (p >= total - 64) bit = (message_bits >> (total - 1 - p)) & 1;
+        else bit = false;
+        out += bit ? '1' : '0';
+    }
+    return out;
+}
+
+TraceOverview::TraceOverview(const Sha256Trace& trace)
+    : trace(trace), low(0), high(0) {
+    for (size_t block = 0; block < trace.blocks(); block++) {
+        uint32_t flips = trace.flipped(block);
+        if (block == 0 || flips < low) low = flips;
+        if (block == 0 || flips > high) high = flips;
+    }
+}
+
+std::string TraceOverview::block_map(size_t width, size_t rows, size_t selected) const {
+    size_t blocks = trace.blocks();
+    if (blocks == 0 || width == 0 || rows == 0) return std::string();
+
+    size_t cells = std::min(blocks, width * rows);
+    size_t per_cell = (blocks + cells - 1) / cells;
+    cells = (blocks + per_cell - 1) / per_cell;
+
+    std::string out;
+    for (size_t cell = 0; cell < cells; cell++) {
+        size_t first = cell * per_cell;
+        size_t last = std::min(first + per_cell, blocks);
+        uint32_t busiest = 0;
+        for (size_t block = first; block < last; block++) {
+            busiest = std::max(busiest, trace.flipped(block));
+        }
+
+        int level = kLevels / 2;
+        if (high > low) {
+            level = static_cast<int>(static_cast<uint64_t>(busiest - low) * (kLevels - 1) / (high - low));
+        }
+
+        bool is_selected = selected >= first && selected < last;
+        if (is_selected) out += "\033[7m";
+        out += kShades[level];
+        if (is_selected) out += "\033[0m";
+        if ((cell + 1) % width == 0 || cell + 1 == cells) out += "\n";
+    }
+
+    out += std::to_string(per_cell) + (per_cell == 1 ? " block" : " blocks") +
+           " per cell, a..h bits flipped: " + std::to_string(low) + " ";
+    for (const char* shade : kShades) out += shade;
+    out += " " + std::to_string(high) + "\n";
+    return out;
+}
+
+std::string TraceOverview::round_map(size_t block) const {
+    static const char kNames[] = "abcdefgh";
+
+    std::string out = "   ";
+    for (int t = 0; t < 64; t += 8) {
+        std::string label = std::to_string(t);
+        out += label;
+        if (t + 8 < 64) out += std::string(8 - label.size(), ' ');
+    }
+    out += "\n";
+
+    std::vector<std::array<uint32_t, 8>> states;
+    for (int t = -1; t < 64; t++) {
+        states.push_back(registers(trace, block, t));
+    }
+
+    for (int i = 0; i < 8; i++) {
+        out += kNames[i];
+        out += "  ";
+        for (int t = 0; t < 64; t++) {
+            // 0..32 bits into five even bands
+            uint32_t bits_flipped = flipped(states[t][i], states[t + 1][i]);
+            out += kShades[bits_flipped * kLevels / 33];
+        }
+        out += "\n";
+    }
+    return out;
+}
@@ -0,0 +1,67 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "SHA.h"
+
+// ============ PBKDF2-HMAC-SHA256 ============
+// T_i = U_1 ^ ... ^ U_c with U_1 = HMAC(P, S || INT(i)) and
+// U_j = HMAC(P, U_j-1). U_1 is a normal HMAC; the remaining c - 1
+// iterations for all jobs go to hmac_iterate_batch().
+
+bool pbkdf2_sha256_batch(const ByteView* passwords, size_t count,
+                         const uint8_t* salt, size_t salt_length, uint32_t iterations,
+                         uint8_t* out, size_t out_length) {
+    // RFC 8018 requires c >= 1
+    if (iterations == 0) return false;
+
+    size_t blocks = (out_length + 31) / 32;
+    size_t jobs = count * blocks;
+
+    std::vector<std::array<uint32_t, 8>> inner(jobs);
+    std::vector<std::array<uint32_t, 8>> outer(jobs);
+    std::vector<Digest> u(jobs);
+    std::vector<Digest> t(jobs);
+
+    std::vector<uint8_t> message(salt, salt + salt_length);
+    message.resize(salt_length + 4);
+
+    for (size_t p = 0; p < count; p++) {
+        HmacSha256 hmac(passwords[p].data, passwords[p].size);
+        for (size_t b = 0; b < blocks; b++) {
+            // block index, 1-based, big-endian
+            uint32_t index = static_cast<uint32_t>(b + 1);
+            message[salt_length + 0] = static_cast<uint8_t>(index >> 24);
+            message[salt_length + 1] = static_cast<uint8_t>(index >> 16);
+            message[salt_length + 2] = static_cast<uint8_t>(index >> 8);
+            message[salt_length + 3] = static_cast<uint8_t>(index);
+
+            size_t j = p * blocks + b;
+            inner[j] = hmac.inner_state();
+            outer[j] = hmac.outer_state();
+            hmac.mac(message.data(), message.size(), u[j]);
+            t[j] = u[j];
+        }
+    }
+
+    if (iterations > 1) {
+        hmac_iterate_batch(inner.data(), outer.data(), u.data(), t.data(), jobs, iterations - 1);
+    }
+
+    for (size_t p = 0; p < count; p++) {
+        uint8_t* dest = out + p * out_length;
+        for (size_t b = 0; b < blocks; b++) {
+            size_t n = std::min<size_t>(32, out_length - b * 32);
+            std::copy(t[p * blocks + b].begin(), t[p * blocks + b].begin() + n, dest + b * 32);
+        }
+    }
+    return true;
+}
+
+bool pbkdf2_sha256(const uint8_t* password, size_t password_length,
+                   const uint8_t* salt, size_t salt_length, uint32_t iterations,
+                   uint8_t* out, size_t out_length) {
+    ByteView view = {password, password_length};
+    return pbkdf2_sha256_batch(&view, 1, salt, salt_length, iterations, out, out_length);
+}
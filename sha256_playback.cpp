@@ -0,0 +1,271 @@
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+#define SHA256_PLAYBACK_TTY 1
+#endif
+
+#include "SHA.h"
+
+// ============ Playback Clock ============
+// Every wait() gets a deadline on the steady clock and then sleeps in
+// poll() on stdin rather than in sleep_for(), so a key press is handled
+// the moment it arrives. Deadlines follow on from the previous one, so
+// the time spent composing and drawing a frame does not stretch the
+// animation. Raw mode is only switched on while waiting; programs that
+// read lines between animations still get a normal terminal.
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+struct NamedSpeed {
+    const char* name;
+    int ms;
+};
+
+const NamedSpeed kSpeeds[] = {
+    {"fastest", 100}, {"fast", 200}, {"normal", 400},
+    {"slow", 600},    {"slowest", 800}, {"end", 1000},
+};
+
+// After a longer gap than this (a pause, a prompt, real work) the next
+// frame is timed from now instead of from the previous deadline
+const Clock::duration kResync = std::chrono::milliseconds(50);
+
+const int kKeyLeft = 0x100;
+const int kKeyRight = 0x101;
+
+int speed_ms(const std::string& speed) {
+    for (const NamedSpeed& named : kSpeeds) {
+        if (speed == named.name) return named.ms;
+    }
+    char* end = nullptr;
+    long ms = std::strtol(speed.c_str(), &end, 10);
+    return end != speed.c_str() && ms > 0 ? static_cast<int>(ms) : 0;
+}
+
+#ifdef SHA256_PLAYBACK_TTY
+struct termios saved_termios;
+volatile sig_atomic_t raw_active = 0;
+
+// Ctrl-C while waiting must not leave the shell without echo or cursor
+void restore_on_signal(int sig) {
+    if (raw_active) {
+        tcsetattr(STDIN_FILENO, TCSANOW, &saved_termios);
+        raw_active = 0;
+    }
+    static const char reset[] = "\033[0m\033[?25h\n";
+    ssize_t ignored = ::write(STDOUT_FILENO, reset, sizeof(reset) - 1);
+    (void)ignored;
+    std::signal(sig, SIG_DFL);
+    std::raise(sig);
+}
+
+void install_restore(int sig) {
+    struct sigaction current;
+    if (sigaction(sig, nullptr, &current) == 0 && current.sa_handler == SIG_DFL) {
+        std::signal(sig, restore_on_signal);
+    }
+}
+#endif
+
+} // namespace
+
+PlaybackClock::PlaybackClock()
+    : mode(Mode::Timed), base(1.0), multiplier(1.0), pause(false), interactive(false),
+      last_deadline(Clock::now()), history(kHistory), newest(0), shown(0) {
+#ifdef SHA256_PLAYBACK_TTY
+    interactive = isatty(STDIN_FILENO) != 0;
+    if (interactive) {
+        // programs with their own handlers exit() from them, which runs
+        // the destructor below instead
+        install_restore(SIGINT);
+        install_restore(SIGTERM);
+    }
+#endif
+}
+
+PlaybackClock::~PlaybackClock() {
+    raw_input(false);
+}
+
+void PlaybackClock::set_speed(double speed) {
+    multiplier = std::min(16.0, std::max(1.0 / 16, speed)) / base;
+}
+
+// g_delay is a plain global the programs assign after startup, so the
+// mode is re-read whenever its value changes; speed picked with +/- is
+// kept on top of it
+void PlaybackClock::sync_mode() {
+    if (g_delay == mode_source) return;
+    mode_source = g_delay;
+    mode = g_delay == "enter" ? Mode::Step : g_delay == "nodelay" ? Mode::NoDelay : Mode::Timed;
+    base = g_delay == "fast" ? 2.0 : 1.0;
+    pause = mode == Mode::Step;
+}
+
+bool PlaybackClock::raw_input(bool on) {
+#ifdef SHA256_PLAYBACK_TTY
+    if (!interactive) return false;
+    if (on && !raw_active) {
+        if (tcgetattr(STDIN_FILENO, &saved_termios) != 0) return false;
+        struct termios raw = saved_termios;
+        raw.c_lflag &= ~(ICANON | ECHO);
+        raw.c_cc[VMIN] = 0;
+        raw.c_cc[VTIME] = 0;
+        if (tcsetattr(STDIN_FILENO, TCSANOW, &raw) != 0) return false;
+        raw_active = 1;
+    } else if (!on && raw_active) {
+        tcsetattr(STDIN_FILENO, TCSANOW, &saved_termios);
+        raw_active = 0;
+    }
+    return true;
+#else
+    (void)on;
+    return false;
+#endif
+}
+
+// -1 on timeout, 0 for input that isn't a key we know
+int PlaybackClock::read_key(int timeout_ms) {
+#ifdef SHA256_PLAYBACK_TTY
+    struct pollfd in = {STDIN_FILENO, POLLIN, 0};
+    if (poll(&in, 1, timeout_ms) <= 0) return -1;
+
+    unsigned char buf[8];
+    ssize_t n = ::read(STDIN_FILENO, buf, sizeof(buf));
+    if (n <= 0) return -1;
+    if (buf[0] == 0x1b) {
+        if (n >= 3 && buf[1] == '[' && buf[2] == 'C') return kKeyRight;
+        if (n >= 3 && buf[1] == '[' && buf[2] == 'D') return kKeyLeft;
+        return 0;
+    }
+    return buf[0];
+#else
+    std::this_thread::sleep_for(std::chrono::milliseconds(std::max(timeout_ms, 0)));
+    return -1;
+#endif
+}
+
+// Returns true when the key ends the wait for the current frame
+bool PlaybackClock::handle(int key, Clock::time_point& deadline, Clock::duration frame) {
+    bool live = shown + 1 >= newest;
+    size_t oldest = newest > kHistory ? newest - kHistory : 0;
+    Clock::time_point now = Clock::now();
+
+    switch (key) {
+    case ' ':
+        pause = !pause;
+        if (!pause) deadline = now + frame;
+        return false;
+
+    case 'n': case '\n': case '\r': case kKeyRight:
+        if (live) return true;
+        shown++;
+        frame_renderer().show(history[shown % kHistory]);
+        return false;
+
+    case 'b': case kKeyLeft:
+        if (newest > 0 && shown > oldest) {
+            pause = true;
+            shown--;
+            frame_renderer().show(history[shown % kHistory]);
+        }
+        return false;
+
+    case '+': case '=':
+        if (speed() < 16.0) {
+            set_speed(speed() * 2);
+            if (deadline > now) deadline = now + (deadline - now) / 2;
+        }
+        return false;
+
+    case '-': case '_':
+        if (speed() > 1.0 / 16) {
+            set_speed(speed() / 2);
+            if (deadline > now) deadline = now + (deadline - now) * 2;
+        }
+        return false;
+
+    case 'q':
+        raw_input(false);
+        std::exit(0);
+
+    default:
+        return false;
+    }
+}
+
+void PlaybackClock::wait(const std::string& speed) {
+    wait(speed_ms(speed));
+}
+
+void PlaybackClock::wait(int ms) {
+    sync_mode();
+    if (mode == Mode::NoDelay) return;
+
+    FrameRenderer& frames = frame_renderer();
+    if (frames.attached()) {
+        history[newest % kHistory] = frames.frame();
+        newest++;
+        shown = newest - 1;
+    }
+
+    Clock::duration frame = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double, std::milli>(ms / speed()));
+
+    if (!interactive || !raw_input(true)) {
+        if (mode == Mode::Step) {
+            std::cin.get();
+        } else {
+            std::this_thread::sleep_for(frame);
+        }
+        return;
+    }
+
+    Clock::time_point now = Clock::now();
+    Clock::time_point start = now - last_deadline < kResync ? last_deadline : now;
+    Clock::time_point deadline = start + frame;
+
+    for (;;) {
+        bool live = shown + 1 >= newest;
+        now = Clock::now();
+        if (!pause && live && now >= deadline) break;
+
+        int timeout = -1;
+        if (!pause) {
+            auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now);
+            timeout = static_cast<int>(std::max<long long>(0, left.count()));
+        }
+
+        int key = read_key(timeout);
+        if (key < 0) {
+            // Playing from a rewound position: move one stored frame on
+            if (!pause && !live && Clock::now() >= deadline) {
+                shown++;
+                frames.show(history[shown % kHistory]);
+                deadline = Clock::now() + frame;
+            }
+            continue;
+        }
+        if (handle(key, deadline, frame)) break;
+    }
+
+    raw_input(false);
+    last_deadline = std::min(deadline, Clock::now());
+}
+
+PlaybackClock& playback_clock() {
+    static PlaybackClock clock;
+    return clock;
+}
@@ -0,0 +1,101 @@
+#include <array>
+#include <cstdint>
+#include <cstddef>
+
+#include "SHA.h"
+
+// ============ SHA-NI Backend ============
+// Compression using the x86 SHA extensions (sha256rnds2, sha256msg1,
+// sha256msg2). The state is kept in two registers in the ABEF/CDGH layout
+// the instructions expect, and converted back once after the last block.
+// Compiled with target attributes so the rest of the build needs no -msha;
+// it is only ever called after shani_supported() said yes.
+
+#if defined(__x86_64__) || defined(__i386__)
+
+#include <cpuid.h>
+#include <immintrin.h>
+
+bool shani_supported() {
+    unsigned int eax, ebx, ecx, edx;
+
+    // SSSE3 (pshufb) and SSE4.1 (pblendw) are used alongside the SHA ops
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) return false;
+    bool ssse3 = ecx & (1u << 9);
+    bool sse41 = ecx & (1u << 19);
+
+    if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) return false;
+    bool sha = ebx & (1u << 29);
+
+    return ssse3 && sse41 && sha;
+}
+
+__attribute__((target("sha,sse4.1")))
+void compress_shani(std::array<uint32_t, 8>& state, const uint8_t* data, size_t blocks) {
+    // byte swap within each 32-bit word (big-endian message words)
+    const __m128i MASK = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+    // a..h -> ABEF / CDGH
+    __m128i tmp = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[0]));
+    __m128i state1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[4]));
+    tmp = _mm_shuffle_epi32(tmp, 0xB1);                  // CDAB
+    state1 = _mm_shuffle_epi32(state1, 0x1B);            // EFGH
+    __m128i state0 = _mm_alignr_epi8(tmp, state1, 8);    // ABEF
+    state1 = _mm_blend_epi16(state1, tmp, 0xF0);         // CDGH
+
+    while (blocks--) {
+        __m128i abef_save = state0;
+        __m128i cdgh_save = state1;
+
+        // message schedule, 4 words at a time
+        __m128i msg[4];
+        for (int i = 0; i < 4; i++) {
+            msg[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i * 16));
+            msg[i] = _mm_shuffle_epi8(msg[i], MASK);
+        }
+
+        #pragma GCC unroll 16
+        for (int q = 0; q < 16; q++) {
+            // W[4q..4q+3] from W[4q-16..4q-1]
+            if (q >= 4) {
+                __m128i t = _mm_sha256msg1_epu32(msg[q & 3], msg[(q + 1) & 3]);
+                t = _mm_add_epi32(t, _mm_alignr_epi8(msg[(q + 3) & 3], msg[(q + 2) & 3], 4));
+                msg[q & 3] = _mm_sha256msg2_epu32(t, msg[(q + 3) & 3]);
+            }
+
+            // two rounds per sha256rnds2, W + K in the low 64 bits
+            __m128i wk = _mm_add_epi32(msg[q & 3],
+                                       _mm_loadu_si128(reinterpret_cast<const __m128i*>(&K[q * 4])));
+            state1 = _mm_sha256rnds2_epu32(state1, state0, wk);
+            wk = _mm_shuffle_epi32(wk, 0x0E);
+            state0 = _mm_sha256rnds2_epu32(state0, state1, wk);
+        }
+
+        // add the compressed chunk to the current hash value
+        state0 = _mm_add_epi32(state0, abef_save);
+        state1 = _mm_add_epi32(state1, cdgh_save);
+
+        data += 64;
+    }
+
+    // ABEF / CDGH -> a..h
+    tmp = _mm_shuffle_epi32(state0, 0x1B);               // FEBA
+    state1 = _mm_shuffle_epi32(state1, 0xB1);            // DCHG
+    state0 = _mm_blend_epi16(tmp, state1, 0xF0);         // DCBA
+    state1 = _mm_alignr_epi8(state1, tmp, 8);            // HGFE
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[0]), state0);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[4]), state1);
+}
+
+#else
+
+bool shani_supported() {
+    return false;
+}
+
+void compress_shani(std::array<uint32_t, 8>& state, const uint8_t* data, size_t blocks) {
+    compress_blocks_scalar(state, data, blocks);
+}
+
+#endif
@@ -0,0 +1,240 @@
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "SHA.h"
+
+// ============ Trace Recording ============
+// The recorder is the plain scalar compression with every round's new a
+// and e written out. Nothing is drawn and nothing sleeps, so a trace of a
+// few kilobytes of input takes microseconds; the animations then only
+// read from it.
+
+namespace {
+
+const uint8_t kTraceMagic[4] = {'S', '2', '5', 'T'};
+const uint8_t kTraceVersion = 1;
+const size_t kTraceHeader = 4 + 1 + 8 + 4;
+const size_t kBlockWords = 8 + 64 + 64 + 64;
+
+uint32_t load_word(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) << 24 | static_cast<uint32_t>(p[1]) << 16 |
+           static_cast<uint32_t>(p[2]) << 8 | static_cast<uint32_t>(p[3]);
+}
+
+uint32_t bit_count(uint32_t x) {
+    return static_cast<uint32_t>(std::bitset<32>(x).count());
+}
+
+void store_word(uint8_t*& p, uint32_t x) {
+    *p++ = static_cast<uint8_t>(x >> 24);
+    *p++ = static_cast<uint8_t>(x >> 16);
+    *p++ = static_cast<uint8_t>(x >> 8);
+    *p++ = static_cast<uint8_t>(x);
+}
+
+} // namespace
+
+void Sha256Trace::record(const uint8_t* data, size_t size) {
+    record(data, size, 0, padded_blocks(size));
+}
+
+void Sha256Trace::record(const uint8_t* data, size_t size, size_t first_block, size_t count) {
+    size_t total = padded_blocks(size);
+    length = size;
+    first = std::min(first_block, total);
+    steps.resize(std::min(count, total - first));
+    flips.assign(total, 0);
+
+    std::array<uint32_t, 8> state;
+    std::copy(IV.begin(), IV.end(), state.begin());
+
+    // The padded tail is at most two blocks: the leftover bytes, 0x80,
+    // zeros and the 64-bit bit length
+    size_t full = size / 64;
+    size_t rest = size - full * 64;
+    uint8_t tail[128] = {0};
+    std::copy(data + full * 64, data + size, tail);
+    tail[rest] = 0x80;
+    size_t tail_blocks = total - full;
+    uint64_t bit_length = static_cast<uint64_t>(size) * 8;
+    for (int i = 1; i <= 8; i++) {
+        tail[tail_blocks * 64 - i] = static_cast<uint8_t>(bit_length);
+        bit_length >>= 8;
+    }
+
+    Block dropped;   // scratch for blocks outside the window
+    for (size_t i = 0; i < total; i++) {
+        const uint8_t* block = i < full ? data + i * 64 : tail + (i - full) * 64;
+        Block& step = i >= first && i - first < steps.size() ? steps[i - first] : dropped;
+        step.initial = state;
+
+        for (int t = 0; t < 16; t++) {
+            step.w[t] = load_word(block + t * 4);
+        }
+        for (int t = 16; t < 64; t++) {
+            step.w[t] = add(sigma1(step.w[t - 2]), step.w[t - 7],
+                            sigma0(step.w[t - 15]), step.w[t - 16]);
+        }
+
+        uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+        uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+        uint32_t flipped_bits = 0;
+        for (int t = 0; t < 64; t++) {
+            uint32_t t1 = add(step.w[t], K[t], usigma1(e), ch(e, f, g), h);
+            uint32_t t2 = add(usigma0(a), maj(a, b, c));
+            flipped_bits += bit_count(a ^ add(t1, t2)) + bit_count(b ^ a) + bit_count(c ^ b) +
+                            bit_count(d ^ c) + bit_count(e ^ add(d, t1)) + bit_count(f ^ e) +
+                            bit_count(g ^ f) + bit_count(h ^ g);
+            h = g;
+            g = f;
+            f = e;
+            e = add(d, t1);
+            d = c;
+            c = b;
+            b = a;
+            a = add(t1, t2);
+            step.a[t] = a;
+            step.e[t] = e;
+        }
+        flips[i] = flipped_bits;
+
+        uint32_t out[8] = {a, b, c, d, e, f, g, h};
+        for (int k = 0; k < 8; k++) {
+            state[k] = add(state[k], out[k]);
+        }
+    }
+    final = state;
+}
+
+void Sha256Trace::record(const std::string& str) {
+    record(reinterpret_cast<const uint8_t*>(str.data()), str.size());
+}
+
+const std::array<uint32_t, 8>& Sha256Trace::state_before(size_t block) const {
+    return steps[block - first].initial;
+}
+
+std::array<uint32_t, 8> Sha256Trace::state_after(size_t block) const {
+    std::array<uint32_t, 8> state = steps[block - first].initial;
+    TraceRound last = round(block, 63);
+    for (int i = 0; i < 8; i++) {
+        state[i] = add(state[i], last.reg[i]);
+    }
+    return state;
+}
+
+const uint32_t* Sha256Trace::schedule(size_t block) const {
+    return steps[block - first].w;
+}
+
+TraceRound Sha256Trace::round(size_t block, int round) const {
+    const Block& step = steps[block - first];
+
+    // After round t, b..d hold a from rounds t-1..t-3 and f..h hold e
+    // from the same rounds; "before round 0" means the block's initial
+    // a..d and e..h
+    auto a_at = [&](int t) { return t >= 0 ? step.a[t] : step.initial[-1 - t]; };
+    auto e_at = [&](int t) { return t >= 0 ? step.e[t] : step.initial[4 + (-1 - t)]; };
+
+    TraceRound out;
+    for (int i = 0; i < 4; i++) {
+        out.reg[i] = a_at(round - i);
+        out.reg[4 + i] = e_at(round - i);
+    }
+    // e = d + T1 and a = T1 + T2, with d the value before this round
+    out.t1 = out.reg[4] - a_at(round - 4);
+    out.t2 = out.reg[0] - out.t1;
+    return out;
+}
+
+Digest Sha256Trace::digest() const {
+    Digest out;
+    uint8_t* p = out.data();
+    for (uint32_t w : final) {
+        store_word(p, w);
+    }
+    return out;
+}
+
+std::vector<uint8_t> Sha256Trace::message() const {
+    std::vector<uint8_t> out(steps.size() * 64);
+    uint8_t* p = out.data();
+    for (const Block& step : steps) {
+        for (int t = 0; t < 16; t++) store_word(p, step.w[t]);
+    }
+    out.resize(static_cast<size_t>(length));
+    return out;
+}
+
+std::vector<uint8_t> Sha256Trace::save() const {
+    std::vector<uint8_t> out(kTraceHeader + steps.size() * kBlockWords * 4);
+    uint8_t* p = out.data();
+    std::copy(kTraceMagic, kTraceMagic + 4, p);
+    p += 4;
+    *p++ = kTraceVersion;
+    for (int i = 7; i >= 0; i--) {
+        *p++ = static_cast<uint8_t>(length >> (i * 8));
+    }
+    store_word(p, static_cast<uint32_t>(steps.size()));
+
+    for (const Block& step : steps) {
+        for (uint32_t w : step.initial) store_word(p, w);
+        for (uint32_t w : step.w) store_word(p, w);
+        for (uint32_t w : step.a) store_word(p, w);
+        for (uint32_t w : step.e) store_word(p, w);
+    }
+    return out;
+}
+
+bool Sha256Trace::load(const uint8_t* data, size_t size) {
+    if (size < kTraceHeader || !std::equal(kTraceMagic, kTraceMagic + 4, data) ||
+        data[4] != kTraceVersion) {
+        return false;
+    }
+
+    uint64_t saved_length = 0;
+    for (int i = 0; i < 8; i++) {
+        saved_length = saved_length << 8 | data[5 + i];
+    }
+    uint64_t count = load_word(data + 13);
+
+    // The message fits in its blocks; checked first, as padded_blocks()
+    // wraps for lengths near 2^64
+    if (saved_length > count * 64 || count != padded_blocks(saved_length) ||
+        (size - kTraceHeader) / (kBlockWords * 4) != count ||
+        (size - kTraceHeader) % (kBlockWords * 4) != 0) {
+        return false;
+    }
+
+    Sha256Trace loaded;
+    loaded.length = saved_length;
+    loaded.steps.resize(count);
+    const uint8_t* p = data + kTraceHeader;
+    for (Block& step : loaded.steps) {
+        for (uint32_t& w : step.initial) { w = load_word(p); p += 4; }
+        for (uint32_t& w : step.w) { w = load_word(p); p += 4; }
+        for (uint32_t& w : step.a) { w = load_word(p); p += 4; }
+        for (uint32_t& w : step.e) { w = load_word(p); p += 4; }
+    }
+
+    // W0..W15 of the blocks are the padded message, so recording it again
+    // must reproduce every stored word
+    std::vector<uint8_t> message = loaded.message();
+    Sha256Trace fresh;
+    fresh.record(message.data(), message.size());
+    for (size_t i = 0; i < count; i++) {
+        const Block& x = loaded.steps[i];
+        const Block& y = fresh.steps[i];
+        if (x.initial != y.initial || !std::equal(x.w, x.w + 64, y.w) ||
+            !std::equal(x.a, x.a + 64, y.a) || !std::equal(x.e, x.e + 64, y.e)) {
+            return false;
+        }
+    }
+
+    *this = std::move(fresh);
+    return true;
+}
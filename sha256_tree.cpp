@@ -0,0 +1,207 @@
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define SHA256_POSIX_IO 1
+#endif
+
+#include "SHA.h"
+
+// ============ Tree Hashing ============
+// A distinct digest, NOT equal to SHA-256 of the file. The input is cut
+// into fixed-size chunks; chunks are hashed in parallel and the digests
+// are combined in a binary tree:
+//
+//   leaf = SHA-256(0x00 || chunk)
+//   node = SHA-256(0x01 || left || right)
+//
+// An odd node at the end of a level moves up unchanged. The prefixes keep
+// leaves and nodes apart, and an empty input is one empty leaf. The chunk
+// size changes the result, so it is part of the label (sha256_tree_name).
+
+namespace {
+
+Digest leaf_digest(const uint8_t* data, size_t size) {
+    const uint8_t prefix = 0x00;
+    Sha256Context ctx;
+    ctx.update(&prefix, 1);
+    ctx.update(data, size);
+    Digest digest;
+    ctx.final(digest);
+    return digest;
+}
+
+Digest combine(std::vector<Digest> level) {
+    uint8_t node[65];
+    node[0] = 0x01;
+    while (level.size() > 1) {
+        size_t pairs = level.size() / 2;
+        for (size_t i = 0; i < pairs; i++) {
+            std::memcpy(node + 1, level[2 * i].data(), 32);
+            std::memcpy(node + 33, level[2 * i + 1].data(), 32);
+            level[i] = sha256_digest(node, sizeof(node));
+        }
+        if (level.size() % 2 == 1) {
+            level[pairs] = level.back();
+            pairs++;
+        }
+        level.resize(pairs);
+    }
+    return level[0];
+}
+
+size_t chunk_count(uint64_t length, size_t chunk_size) {
+    return length == 0 ? 1 : static_cast<size_t>((length + chunk_size - 1) / chunk_size);
+}
+
+// Runs leaf(i) for every chunk on `threads` workers
+template <typename Leaf>
+void for_each_chunk(size_t chunks, size_t threads, Leaf leaf) {
+    std::atomic<size_t> next(0);
+    auto worker = [&]() {
+        for (size_t i = next++; i < chunks; i = next++) {
+            leaf(i);
+        }
+    };
+
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads = std::min(threads, chunks);
+    std::vector<std::thread> pool;
+    for (size_t t = 1; t < threads; t++) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& t : pool) {
+        t.join();
+    }
+}
+
+} // namespace
+
+std::string sha256_tree_name(size_t chunk_size) {
+    if (chunk_size == 0) return std::string();
+    if (chunk_size % (1 << 20) == 0) return "SHA256-TREE-" + std::to_string(chunk_size >> 20) + "M";
+    if (chunk_size % (1 << 10) == 0) return "SHA256-TREE-" + std::to_string(chunk_size >> 10) + "K";
+    return "SHA256-TREE-" + std::to_string(chunk_size);
+}
+
+bool sha256_tree(const uint8_t* data, size_t length, size_t chunk_size, size_t threads,
+                 Digest& digest) {
+    if (chunk_size == 0) {
+        return false;
+    }
+    std::vector<Digest> leaves(chunk_count(length, chunk_size));
+    for_each_chunk(leaves.size(), threads, [&](size_t i) {
+        size_t offset = i * chunk_size;
+        leaves[i] = leaf_digest(data + offset, std::min(chunk_size, length - offset));
+    });
+    digest = combine(std::move(leaves));
+    return true;
+}
+
+// Each worker reads its own chunks with positioned reads, so no chunk is
+// read twice and memory use is one chunk per thread
+bool sha256_tree_file(const std::string& path, size_t chunk_size, size_t threads, Digest& digest) {
+    if (chunk_size == 0) {
+        return false;
+    }
+#ifdef SHA256_POSIX_IO
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+        // pipes and devices have no size or offsets: hash chunks in order
+        std::vector<Digest> leaves;
+        std::vector<uint8_t> chunk(chunk_size);
+        bool ok = true;
+        for (;;) {
+            size_t filled = 0;
+            while (filled < chunk_size) {
+                ssize_t n = ::read(fd, chunk.data() + filled, chunk_size - filled);
+                if (n < 0 && errno == EINTR) continue;
+                if (n <= 0) {
+                    ok = n == 0;
+                    break;
+                }
+                filled += static_cast<size_t>(n);
+            }
+            if (!ok || (filled == 0 && !leaves.empty())) {
+                break;
+            }
+            leaves.push_back(leaf_digest(chunk.data(), filled));
+            if (filled < chunk_size) {
+                break;
+            }
+        }
+        ::close(fd);
+        if (ok) {
+            digest = combine(std::move(leaves));
+        }
+        return ok;
+    }
+
+    uint64_t length = static_cast<uint64_t>(st.st_size);
+    std::vector<Digest> leaves(chunk_count(length, chunk_size));
+    std::atomic<bool> failed(false);
+    for_each_chunk(leaves.size(), threads, [&](size_t i) {
+        thread_local std::vector<uint8_t> chunk;
+        chunk.resize(chunk_size);
+        uint64_t offset = static_cast<uint64_t>(i) * chunk_size;
+        size_t want = static_cast<size_t>(std::min<uint64_t>(chunk_size, length - offset));
+        size_t filled = 0;
+        while (filled < want) {
+            ssize_t n = ::pread(fd, chunk.data() + filled, want - filled,
+                                static_cast<off_t>(offset + filled));
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) {
+                failed = true;
+                return;
+            }
+            filled += static_cast<size_t>(n);
+        }
+        leaves[i] = leaf_digest(chunk.data(), want);
+    });
+    ::close(fd);
+#else
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        return false;
+    }
+    uint64_t length = static_cast<uint64_t>(file.tellg());
+    file.close();
+
+    std::vector<Digest> leaves(chunk_count(length, chunk_size));
+    std::atomic<bool> failed(false);
+    for_each_chunk(leaves.size(), threads, [&](size_t i) {
+        std::ifstream in(path, std::ios::binary);
+        std::vector<char> chunk(chunk_size);
+        uint64_t offset = static_cast<uint64_t>(i) * chunk_size;
+        size_t want = static_cast<size_t>(std::min<uint64_t>(chunk_size, length - offset));
+        in.seekg(static_cast<std::streamoff>(offset));
+        if (!in.read(chunk.data(), want)) {
+            failed = true;
+            return;
+        }
+        leaves[i] = leaf_digest(reinterpret_cast<const uint8_t*>(chunk.data()), want);
+    });
+#endif
+    if (failed) {
+        return false;
+    }
+    digest = combine(std::move(leaves));
+    return true;
+}
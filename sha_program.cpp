@@ -0,0 +1,670 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+
+#include "SHA.h"
+
+// ============ sha_program ============
+// Command-line front end to libsha256: one-shot hashing of a string, hex,
+// binary or file argument, plus the sha256sum-style, mining, Merkle,
+// PBKDF2, chunking and trace modes below.
+
+// ============ Multi-File Mode ============
+// sha256sum-compatible output for many files, hashed on a pool of worker
+// threads. Lines come out in input order by default; --unordered prints
+// each file as soon as it is done so one slow file doesn't hold up the
+// rest.
+
+struct FileJob {
+    std::string path;
+    Digest expected;   // --check only
+    Digest digest;
+    bool ok;
+};
+
+struct MultiOptions {
+    size_t jobs = 0;   // 0: one per core
+    bool ordered = true;
+    bool check = false;
+    bool from_stdin = false;
+    bool tree = false;
+    size_t chunk = kTreeChunkDefault;
+    std::vector<std::string> args;
+};
+
+// sha256sum escapes '\\' and '\n' in names and marks such lines with a
+// leading backslash
+static std::string escape_path(const std::string& path, bool& escaped) {
+    std::string out;
+    escaped = false;
+    for (char c : path) {
+        if (c == '\\') {
+            out += "\\\\";
+            escaped = true;
+        } else if (c == '\n') {
+            out += "\\n";
+            escaped = true;
+        } else {
+            out += c;
+        }
+    }
+    return out;
+}
+
+static std::string unescape_path(const std::string& path) {
+    std::string out;
+    for (size_t i = 0; i < path.size(); i++) {
+        if (path[i] == '\\' && i + 1 < path.size()) {
+            i++;
+            out += path[i] == 'n' ? '\n' : path[i];
+        } else {
+            out += path[i];
+        }
+    }
+    return out;
+}
+
+static int hex_value(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+// "<64 hex>  <path>" or "<64 hex> *<path>", optionally '\'-escaped
+static bool parse_check_line(std::string line, FileJob& job) {
+    bool escaped = !line.empty() && line[0] == '\\';
+    if (escaped) {
+        line.erase(0, 1);
+    }
+    if (line.size() < 67 || line[64] != ' ' || (line[65] != ' ' && line[65] != '*')) {
+        return false;
+    }
+    for (int i = 0; i < 32; i++) {
+        int hi = hex_value(line[i * 2]);
+        int lo = hex_value(line[i * 2 + 1]);
+        if (hi < 0 || lo < 0) {
+            return false;
+        }
+        job.expected[i] = static_cast<uint8_t>(hi << 4 | lo);
+    }
+    job.path = line.substr(66);
+    if (escaped) {
+        job.path = unescape_path(job.path);
+    }
+    return true;
+}
+
+// Runs hash() for every job on `threads` workers. report() is called once per job,
+// serialised under a lock, either in input order or in completion order.
+template <typename Hash, typename Report>
+static void run_jobs(std::vector<FileJob>& jobs, size_t threads, bool ordered, Hash hash, Report report) {
+    std::atomic<size_t> next_job(0);
+    std::mutex report_lock;
+    std::vector<char> done(jobs.size(), 0);
+    size_t next_report = 0;
+
+    auto worker = [&]() {
+        for (;;) {
+            size_t i = next_job.fetch_add(1);
+            if (i >= jobs.size()) {
+                return;
+            }
+            FileJob& job = jobs[i];
+            job.ok = hash(job.path, job.digest);
+
+            std::lock_guard<std::mutex> guard(report_lock);
+            if (!ordered) {
+                report(job);
+                continue;
+            }
+            done[i] = 1;
+            while (next_report < jobs.size() && done[next_report]) {
+                report(jobs[next_report++]);
+            }
+        }
+    };
+
+    threads = std::max<size_t>(1, std::min(threads, jobs.size()));
+    std::vector<std::thread> pool;
+    for (size_t t = 1; t < threads; t++) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& t : pool) {
+        t.join();
+    }
+}
+
+// "4096", "64K", "1M", "2G"; 0 if malformed
+static size_t parse_size(const std::string& text) {
+    if (text.empty() || text[0] < '0' || text[0] > '9') {
+        return 0;   // strtoull would accept "-1" and wrap it
+    }
+    char* end = nullptr;
+    unsigned long long n = std::strtoull(text.c_str(), &end, 10);
+    std::string suffix = end;
+    if (suffix == "K" || suffix == "k") n <<= 10;
+    else if (suffix == "M" || suffix == "m") n <<= 20;
+    else if (suffix == "G" || suffix == "g") n <<= 30;
+    else if (!suffix.empty()) return 0;
+    return static_cast<size_t>(n);
+}
+
+static int multi_usage() {
+    std::cerr << "Usage: sha_program [--jobs N] [--unordered] [--stdin] FILE...\n"
+              << "       sha_program --tree [--chunk N] [--jobs N] FILE...\n"
+              << "       sha_program [--jobs N] [--unordered] --check MANIFEST...\n"
+              << "  --jobs N     worker threads (default: one per core)\n"
+              << "  --unordered  print results as they finish, not in input order\n"
+              << "  --stdin      read the file list from stdin, one path per line\n"
+              << "  --check      verify sha256sum manifests instead of hashing\n"
+              << "  --tree       parallel tree digest per file (not SHA-256, see sha256_tree.cpp)\n"
+              << "  --chunk N    tree chunk size, K/M/G suffixes allowed (default 1M)\n";
+    return 2;
+}
+
+static int multi_main(int argc, char* argv[]) {
+    MultiOptions opt;
+    bool options_done = false;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (options_done || arg.size() < 2 || arg.compare(0, 2, "--") != 0) {
+            opt.args.push_back(arg);
+        } else if (arg == "--") {
+            options_done = true;
+        } else if (arg == "--jobs" && i + 1 < argc) {
+            opt.jobs = std::strtoul(argv[++i], nullptr, 10);
+        } else if (arg == "--unordered") {
+            opt.ordered = false;
+        } else if (arg == "--stdin") {
+            opt.from_stdin = true;
+        } else if (arg == "--check") {
+            opt.check = true;
+        } else if (arg == "--tree") {
+            opt.tree = true;
+        } else if (arg == "--chunk" && i + 1 < argc) {
+            opt.chunk = parse_size(argv[++i]);
+            if (opt.chunk == 0) {
+                return multi_usage();
+            }
+        } else {
+            return multi_usage();
+        }
+    }
+    if (opt.jobs == 0) {
+        opt.jobs = std::max(1u, std::thread::hardware_concurrency());
+    }
+    if (opt.tree && opt.check) {
+        std::cerr << "--check only verifies sha256sum manifests, not --tree output" << std::endl;
+        return 2;
+    }
+
+    // Input paths: arguments, then stdin if asked
+    std::vector<std::string> inputs = opt.args;
+    if (opt.from_stdin) {
+        std::string line;
+        while (std::getline(std::cin, line)) {
+            if (!line.empty()) {
+                inputs.push_back(line);
+            }
+        }
+    }
+    if (inputs.empty()) {
+        return multi_usage();
+    }
+
+    std::vector<FileJob> jobs;
+    size_t malformed = 0;
+    if (opt.check) {
+        for (const std::string& manifest : inputs) {
+            std::ifstream in(manifest);
+            if (!in) {
+                std::cerr << manifest << ": No such file or directory" << std::endl;
+                return 1;
+            }
+            std::string line;
+            while (std::getline(in, line)) {
+                FileJob job = {};
+                if (!parse_check_line(line, job)) {
+                    malformed++;
+                } else {
+                    jobs.push_back(job);
+                }
+            }
+        }
+    } else {
+        for (const std::string& path : inputs) {
+            FileJob job = {};
+            job.path = path;
+            jobs.push_back(job);
+        }
+    }
+
+    size_t unreadable = 0;
+    size_t mismatched = 0;
+    // Tree mode spends the threads inside each file instead of across files
+    size_t file_threads = opt.tree ? 1 : opt.jobs;
+    auto hash = [&](const std::string& path, Digest& digest) {
+        if (opt.tree) {
+            return sha256_tree_file(path, opt.chunk, opt.jobs, digest);
+        }
+        return sha256_file(path, digest);
+    };
+    std::string tree_name = sha256_tree_name(opt.chunk);
+
+    run_jobs(jobs, file_threads, opt.ordered, hash, [&](const FileJob& job) {
+        // Names are escaped on every stdout line, as sha256sum does, so
+        // a newline in one can't forge another line
+        bool escaped;
+        std::string name = escape_path(job.path, escaped);
+        if (!job.ok) {
+            unreadable++;
+            if (opt.check) {
+                std::cout << (escaped ? "\\" : "") << name << ": FAILED open or read\n";
+            } else {
+                std::cerr << "sha_program: " << job.path << ": cannot read file\n";
+            }
+            return;
+        }
+        if (opt.check) {
+            bool match = job.digest == job.expected;
+            if (!match) {
+                mismatched++;
+            }
+            std::cout << (escaped ? "\\" : "") << name << (match ? ": OK\n" : ": FAILED\n");
+            return;
+        }
+        char line[64];
+        to_hex(job.digest, line);
+        if (opt.tree) {
+            // BSD-style tagged line, so it can't be mistaken for SHA-256
+            if (escaped) {
+                std::cout << '\\';
+            }
+            std::cout << tree_name << " (" << name << ") = ";
+            std::cout.write(line, sizeof(line));
+            std::cout << '\n';
+            return;
+        }
+        if (escaped) {
+            std::cout << '\\';
+        }
+        std::cout.write(line, sizeof(line));
+        std::cout << "  " << name << '\n';
+    });
+    std::cout.flush();
+
+    if (malformed > 0) {
+        std::cerr << "WARNING: " << malformed << " line(s) are improperly formatted" << std::endl;
+    }
+    if (opt.check && unreadable > 0) {
+        std::cerr << "WARNING: " << unreadable << " listed file(s) could not be read" << std::endl;
+    }
+    if (mismatched > 0) {
+        std::cerr << "WARNING: " << mismatched << " computed checksum(s) did NOT match" << std::endl;
+    }
+    return (unreadable > 0 || mismatched > 0 || malformed > 0) ? 1 : 0;
+}
+
+// ============ Mining Mode ============
+// --mine: nonce search over an 80-byte block header, by default the
+// genesis header hash.cpp shows. The target comes from the header's nBits
+// unless --bits or --target overrides it; an easy target turns this into
+// a local load generator.
+
+static const char* kGenesisHeader =
+    "0100000000000000000000000000000000000000000000000000000000000000000000003ba3edfd7a7b12b27ac72c3e67768f617fc81bc3888a51323a9fb8aa4b1e5e4a29ab5f49ffff001d1dac2b7c";
+
+static bool parse_hex_bytes(const std::string& text, std::vector<uint8_t>& out) {
+    std::string hexStr = text.compare(0, 2, "0x") == 0 ? text.substr(2) : text;
+    if (hexStr.size() % 2 != 0) {
+        return false;
+    }
+    out.clear();
+    for (size_t i = 0; i < hexStr.size(); i += 2) {
+        int hi = hex_value(hexStr[i]);
+        int lo = hex_value(hexStr[i + 1]);
+        if (hi < 0 || lo < 0) {
+            return false;
+        }
+        out.push_back(static_cast<uint8_t>(hi << 4 | lo));
+    }
+    return true;
+}
+
+static int mine_usage() {
+    std::cerr << "Usage: sha_program --mine [--header HEX] [--bits HEX | --target HEX]\n"
+              << "                          [--start N] [--count N] [--jobs N]\n"
+              << "  --header HEX  80-byte block header (default: genesis block)\n"
+              << "  --bits HEX    compact target, e.g. 1d00ffff (default: from header)\n"
+              << "  --target HEX  full 256-bit target, 64 hex digits\n"
+              << "  --start N     first nonce to try (default: 0)\n"
+              << "  --count N     nonces to try (default: all 2^32)\n"
+              << "  --jobs N      worker threads (default: one per core)\n";
+    return 2;
+}
+
+static int mine_main(int argc, char* argv[]) {
+    std::vector<uint8_t> header;
+    parse_hex_bytes(kGenesisHeader, header);
+
+    bool have_target = false;
+    Digest target = {};
+    uint32_t start = 0;
+    uint64_t count = uint64_t(1) << 32;
+    size_t jobs = 0;
+
+    for (int i = 2; i < argc; i++) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            return mine_usage();
+        }
+        std::string value = argv[++i];
+        std::vector<uint8_t> raw;
+        if (arg == "--header") {
+            if (!parse_hex_bytes(value, raw) || raw.size() != 80) {
+                std::cerr << "--header needs 80 bytes of hex" << std::endl;
+                return 2;
+            }
+            header = raw;
+        } else if (arg == "--bits") {
+            target = target_from_bits(std::strtoul(value.c_str(), nullptr, 16));
+            have_target = true;
+        } else if (arg == "--target") {
+            if (!parse_hex_bytes(value, raw) || raw.size() != 32) {
+                std::cerr << "--target needs 64 hex digits" << std::endl;
+                return 2;
+            }
+            std::copy(raw.begin(), raw.end(), target.begin());
+            have_target = true;
+        } else if (arg == "--start") {
+            start = static_cast<uint32_t>(std::strtoul(value.c_str(), nullptr, 0));
+        } else if (arg == "--count") {
+            count = std::strtoull(value.c_str(), nullptr, 0);
+        } else if (arg == "--jobs") {
+            jobs = std::strtoul(value.c_str(), nullptr, 10);
+        } else {
+            return mine_usage();
+        }
+    }
+
+    if (!have_target) {
+        // nBits: header bytes 72..75, little-endian
+        uint32_t bits = header[72] | header[73] << 8 | header[74] << 16 |
+                        static_cast<uint32_t>(header[75]) << 24;
+        target = target_from_bits(bits);
+    }
+
+    MineResult result = sha256d_mine(header.data(), target, jobs, start, count);
+
+    // Block hashes are conventionally shown byte-reversed
+    Digest shown = result.hash;
+    std::reverse(shown.begin(), shown.end());
+
+    if (result.found) {
+        std::cout << "nonce:  " << result.nonce << " (0x" << hex(result.nonce) << ")\n"
+                  << "hash:   " << to_hex(shown) << "\n";
+    } else {
+        std::cout << "no nonce found\n";
+    }
+    double rate = result.seconds > 0 ? result.hashes / result.seconds : 0;
+    std::cout << "hashes: " << result.hashes << " in " << result.seconds << " s ("
+              << rate / 1e6 << " MH/s)" << std::endl;
+    return result.found ? 0 : 1;
+}
+
+// ============ Merkle Benchmark ============
+// --merkle-bench [LEAVES]: root of a synthetic tree (leaf i = sha256d of
+// its index), built pair-by-pair with sha256d() and then with the batched,
+// threaded merkle_root(), so the two timings and roots can be compared.
+
+static int merkle_bench_main(int argc, char* argv[]) {
+    size_t count = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1000000;
+    if (count == 0) {
+        std::cerr << "Usage: sha_program --merkle-bench [LEAVES]" << std::endl;
+        return 2;
+    }
+
+    std::vector<Digest> leaves(count);
+    for (size_t i = 0; i < count; i++) {
+        uint64_t id = i;
+        leaves[i] = sha256d(reinterpret_cast<const uint8_t*>(&id), sizeof(id));
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<Digest> level = leaves;
+    while (level.size() > 1) {
+        if (level.size() % 2 == 1) {
+            level.push_back(level.back());
+        }
+        for (size_t i = 0; i < level.size() / 2; i++) {
+            level[i] = sha256d(level[2 * i].data(), 64);
+        }
+        level.resize(level.size() / 2);
+    }
+    std::chrono::duration<double> naive = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    Digest root = merkle_root(leaves.data(), leaves.size());
+    std::chrono::duration<double> batched = std::chrono::steady_clock::now() - start;
+
+    std::cout << "leaves:   " << count << "\n"
+              << "root:     " << to_hex(root) << "\n"
+              << "sha256d:  " << naive.count() << " s\n"
+              << "batched:  " << batched.count() << " s ("
+              << sha256_batch_lanes() << " lanes, "
+              << std::max(1u, std::thread::hardware_concurrency()) << " threads)\n";
+    if (root != level[0]) {
+        std::cerr << "root mismatch: " << to_hex(level[0]) << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+// ============ PBKDF2 Benchmark ============
+// --pbkdf2-bench [ITERATIONS]: iterations/second for one password on its
+// own, then for a batch of candidates filling every SIMD lane.
+
+static int pbkdf2_bench_main(int argc, char* argv[]) {
+    uint32_t iterations = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 600000;
+    if (iterations == 0) {
+        std::cerr << "Usage: sha_program --pbkdf2-bench [ITERATIONS]" << std::endl;
+        return 2;
+    }
+    const std::string salt = "benchmark-salt";
+    const uint8_t* salt_bytes = reinterpret_cast<const uint8_t*>(salt.data());
+
+    uint8_t key[32];
+    auto start = std::chrono::steady_clock::now();
+    pbkdf2_sha256(reinterpret_cast<const uint8_t*>("password"), 8, salt_bytes, salt.size(),
+                  iterations, key, sizeof(key));
+    std::chrono::duration<double> single = std::chrono::steady_clock::now() - start;
+
+    size_t count = std::max<size_t>(sha256_batch_lanes(), 4);
+    std::vector<std::string> passwords;
+    std::vector<ByteView> views;
+    for (size_t i = 0; i < count; i++) {
+        passwords.push_back("password" + std::to_string(i));
+    }
+    for (const std::string& p : passwords) {
+        views.push_back({reinterpret_cast<const uint8_t*>(p.data()), p.size()});
+    }
+    std::vector<uint8_t> keys(count * 32);
+    start = std::chrono::steady_clock::now();
+    pbkdf2_sha256_batch(views.data(), count, salt_bytes, salt.size(), iterations,
+                        keys.data(), 32);
+    std::chrono::duration<double> batch = std::chrono::steady_clock::now() - start;
+
+    std::cout << "iterations: " << iterations << "\n"
+              << "single:     " << single.count() << " s ("
+              << iterations / single.count() << " it/s)\n"
+              << "batch of " << count << ": " << batch.count() << " s ("
+              << count * iterations / batch.count() << " it/s, "
+              << sha256_batch_lanes() << " lanes)" << std::endl;
+    return 0;
+}
+
+// ============ Chunking Mode ============
+// --cdc: content-defined chunks of one file (or - for stdin), one
+// "offset length sha256" line per chunk, for dedup indexing.
+
+static int cdc_usage() {
+    std::cerr << "Usage: sha_program --cdc [--min N] [--avg N] [--max N] [--jobs N] FILE|-\n"
+              << "  sizes take K/M suffixes; defaults 2K / 8K / 64K, avg a power of two\n";
+    return 2;
+}
+
+static int cdc_main(int argc, char* argv[]) {
+    CdcParams params;
+    size_t jobs = 0;
+    std::string path;
+    for (int i = 2; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg.compare(0, 2, "--") != 0) {
+            path = arg;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            return cdc_usage();
+        }
+        std::string value = argv[++i];
+        if (arg == "--min") params.min_size = parse_size(value);
+        else if (arg == "--avg") params.avg_size = parse_size(value);
+        else if (arg == "--max") params.max_size = parse_size(value);
+        else if (arg == "--jobs") jobs = std::strtoul(value.c_str(), nullptr, 10);
+        else return cdc_usage();
+    }
+    if (path.empty()) {
+        return cdc_usage();
+    }
+    if (!params.valid()) {
+        std::cerr << "Invalid sizes: need 0 < min <= avg <= max, avg a power of two" << std::endl;
+        return cdc_usage();
+    }
+
+    char line[64];
+    auto emit = [&](const ChunkRecord& record) {
+        to_hex(record.digest, line);
+        std::cout << record.offset << ' ' << record.length << ' ';
+        std::cout.write(line, sizeof(line));
+        std::cout << '\n';
+    };
+
+    bool ok = path == "-" ? sha256_cdc(std::cin, params, jobs, emit)
+                          : sha256_cdc_file(path, params, jobs, emit);
+    std::cout.flush();
+    if (!ok) {
+        std::cerr << "Cannot read " << path << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+// ============ Trace Mode ============
+// --trace: records the full computation for FILE (or - for stdin) with
+// Sha256Trace and writes the binary trace to OUT for the animations to
+// replay (padding --trace OUT, translation --trace OUT). Traces take 800
+// bytes per 64-byte block, so this is meant for inputs of a visualisable
+// size, not bulk data.
+
+static int trace_main(int argc, char* argv[]) {
+    if (argc != 4) {
+        std::cerr << "Usage: sha_program --trace FILE|- OUT" << std::endl;
+        return 2;
+    }
+    std::string path = argv[2];
+
+    std::string data;
+    if (path == "-") {
+        data.assign(std::istreambuf_iterator<char>(std::cin), std::istreambuf_iterator<char>());
+    } else {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) {
+            std::cerr << "Cannot open " << path << std::endl;
+            return 1;
+        }
+        data.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    Sha256Trace trace;
+    trace.record(data);
+    std::chrono::duration<double, std::micro> took = std::chrono::steady_clock::now() - start;
+
+    std::vector<uint8_t> saved = trace.save();
+    std::ofstream out(argv[3], std::ios::binary);
+    out.write(reinterpret_cast<const char*>(saved.data()), saved.size());
+    if (!out.flush()) {
+        std::cerr << "Cannot write " << argv[3] << std::endl;
+        return 1;
+    }
+
+    std::cout << to_hex(trace.digest()) << "  " << path << "\n"
+              << trace.blocks() << " blocks, " << saved.size() << " bytes of trace, recorded in "
+              << took.count() << " us" << std::endl;
+    return 0;
+}
+
+// ============ Main ============
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && std::string(argv[1]) == "--mine") {
+        return mine_main(argc, argv);
+    }
+    if (argc > 1 && std::string(argv[1]) == "--merkle-bench") {
+        return merkle_bench_main(argc, argv);
+    }
+    if (argc > 1 && std::string(argv[1]) == "--pbkdf2-bench") {
+        return pbkdf2_bench_main(argc, argv);
+    }
+    if (argc > 1 && std::string(argv[1]) == "--cdc") {
+        return cdc_main(argc, argv);
+    }
+    if (argc > 1 && std::string(argv[1]) == "--trace") {
+        return trace_main(argc, argv);
+    }
+
+    // Several arguments or any --option: hash files sha256sum-style
+    if (argc > 2 || (argc == 2 && std::string(argv[1]).compare(0, 2, "--") == 0)) {
+        return multi_main(argc, argv);
+    }
+
+    if (argc > 1) {
+        std::string input = argv[1];
+        std::string type = input_type(input);
+        
+        if (type == "file") {
+            Digest digest;
+            if (!sha256_file(input, digest)) {
+                std::cerr << "Cannot read file: " << input << std::endl;
+                return 1;
+            }
+            std::cout << to_hex(digest) << std::endl;
+        } else {
+            std::string str;
+            if (type == "binary" || type == "hex") {
+                auto byteVec = bytes(input, type);
+                str = std::string(byteVec.begin(), byteVec.end());
+            } else {
+                str = input;
+            }
+            std::cout << sha256(str) << std::endl;
+        }
+    } else {
+        // Test with "abc" which should produce:
+        // ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad
+        std::cout << "SHA-256 of \"abc\": " << sha256("abc") << std::endl;
+    }
+    
+    return 0;
+}
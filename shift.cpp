@@ -1,5 +1,6 @@
 #include <iostream>
 #include <string>
+#include <algorithm>
 #include <bitset>
 #include <thread>
 #include <chrono>
@@ -7,34 +8,15 @@
 #include <iomanip>
 #include <cmath>
 
+#include "SHA.h"
+
 // ============ Global Variables ============
-std::string g_delay = "normal";
 bool g_showBinary = true;
 bool g_showHex = true;
 bool g_showDecimal = false;
 
 // ============ Utility Functions ============
 
-void clearScreen() {
-    std::cout << "\033[2J\033[1;1H";
-}
-
-void delay(int ms) {
-    if (g_delay != "nodelay" && g_delay != "enter") {
-        std::this_thread::sleep_for(std::chrono::milliseconds(ms));
-    }
-}
-
-void waitForEnter() {
-    if (g_delay == "enter") {
-        std::cin.get();
-    }
-}
-
-std::string bits(uint32_t x) {
-    return std::bitset<32>(x).to_string();
-}
-
 std::string bitsWithSpaces(uint32_t x) {
     std::string b = bits(x);
     std::string result;
@@ -45,18 +27,6 @@ std::string bitsWithSpaces(uint32_t x) {
     return result;
 }
 
-std::string hex(uint32_t x) {
-    std::stringstream ss;
-    ss << std::hex << std::setfill('0') << std::setw(8) << x;
-    return ss.str();
-}
-
-// ============ Shift Right Function ============
-
-uint32_t shr(int n, uint32_t x) {
-    return x >> n;
-}
-
 // ============ Interactive Mode ============
 
 void interactiveMode() {
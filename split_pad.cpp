@@ -5,31 +5,10 @@
 #include <thread>
 #include <chrono>
 
+#include "SHA.h"
 
 using namespace std;
 
-void delay(const string& level){
-	if (level == "normal"){
-		this_thread::sleep_for(chrono::milliseconds(400));
-	}else if (level == "slow"){
-		this_thread::sleep_for(chrono::seconds(1));
-	}
-
-}
-
-vector split(const string& input, size_t blockSize){
-	vector block;
-	for (size_t i=0; i< input.size(); i+= blockSize){
-		blocks.push_back(input.substr(i, blockSize));
-	}
-	return blocks;
-}
-
-string padding(const string& message){
-	size_t padLen =(512 -( message.size() % 512)) %512;
-	return message + (padLen, '0');
-}
-
 int main (int argc, char* argv[]) {
 	string input ="abc";
 	string message;
@@ -45,9 +24,9 @@ int main (int argc, char* argv[]) {
 	}
 
 	string padded = padding(message);
-	vector blocks = split (padded , 512);
+	vector<string> blocks = split(padded, 512);
 
-	system ("clear"); // use cls on windows
+	clearScreen();
 	string state = "";
 	if (!state.empty())
 		cout << state << "\n";
@@ -57,21 +36,21 @@ int main (int argc, char* argv[]) {
     	cout << "--------------\n";
 	delay("normal");
 
-	system("clear");
+	clearScreen();
 	if (!state.empty()) std::cout << state << "\n";
     	cout << "--------------\n";
     	cout << "message blocks:\n";
     	cout << "--------------\n";
 
 	for (size_t i=0 ; i< blocks.size(); i++){
-		cout << i << ":" << block[i] << "\n";
+		cout << i << ":" << blocks[i] << "\n";
 		delay("normal");
 	}
 	delay ("slow");
 
 	string contents;
 	for (size_t i=0 ; i< blocks.size(); i++){
-		content += to_string(i) +":" + block[i];
+		contents += to_string(i) +":" + blocks[i];
 		if (i < blocks.size() -1) contents += "\n";
 	}
 
@@ -79,5 +58,5 @@ int main (int argc, char* argv[]) {
 
 	cout << state << "\n";
 
-	return 0
+	return 0;
 }
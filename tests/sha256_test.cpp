@@ -0,0 +1,340 @@
+// Known-answer and cross-check tests for libsha256. Run through
+// `make test`, which repeats them with SHA256_BACKEND=scalar and
+// SHA256_LANES=1/4/8 so every kernel gets the same vectors.
+
+#include <cstring>
+#include <random>
+#include <sstream>
+
+#include "SHA.h"
+
+// ============ Checks ============
+
+namespace {
+
+int g_failures = 0;
+
+#define CHECK(cond) check((cond), #cond, __FILE__, __LINE__)
+
+void check(bool ok, const char* what, const char* file, int line) {
+    if (!ok) {
+        std::cerr << file << ":" << line << ": FAIL " << what << std::endl;
+        g_failures++;
+    }
+}
+
+std::string hex_of(const uint8_t* data, size_t size) {
+    static const char kDigits[] = "0123456789abcdef";
+    std::string out;
+    for (size_t i = 0; i < size; i++) {
+        out += kDigits[data[i] >> 4];
+        out += kDigits[data[i] & 15];
+    }
+    return out;
+}
+
+const uint8_t* bytes_of(const std::string& s) {
+    return reinterpret_cast<const uint8_t*>(s.data());
+}
+
+std::vector<uint8_t> random_bytes(size_t size, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::vector<uint8_t> out(size);
+    for (uint8_t& b : out) b = static_cast<uint8_t>(rng());
+    return out;
+}
+
+// ============ SHA-256 (FIPS 180-4 examples) ============
+
+void test_sha256() {
+    CHECK(sha256("") == "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+    CHECK(sha256("abc") == "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+    CHECK(sha256("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq") ==
+          "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+    CHECK(to_hex(sha256_digest(std::string(1000000, 'a'))) ==
+          "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+}
+
+// ============ Backends ============
+
+// SHA-NI against the portable kernel, block by block and through sha256()
+void test_backends() {
+    if (!sha256_backend_supported(Sha256Backend::ShaNi)) {
+        std::cout << "  (no SHA-NI on this CPU, cross-check skipped)" << std::endl;
+        return;
+    }
+
+    std::vector<uint8_t> data = random_bytes(64 * 40, 1);
+    for (size_t blocks = 1; blocks <= 40; blocks += 3) {
+        std::array<uint32_t, 8> a, b;
+        std::copy(IV.begin(), IV.end(), a.begin());
+        b = a;
+        compress_shani(a, data.data(), blocks);
+        compress_blocks_scalar(b, data.data(), blocks);
+        CHECK(a == b);
+    }
+
+    Sha256Backend picked = sha256_get_backend();
+    for (size_t length = 0; length < 300; length += 7) {
+        CHECK(sha256_set_backend(Sha256Backend::Scalar));
+        Digest scalar = sha256_digest(data.data(), length);
+        CHECK(sha256_set_backend(Sha256Backend::ShaNi));
+        Digest shani = sha256_digest(data.data(), length);
+        CHECK(scalar == shani);
+    }
+    sha256_set_backend(picked);
+}
+
+// ============ Streaming Context ============
+
+void test_context() {
+    std::vector<uint8_t> data = random_bytes(1000, 2);
+    Digest expected = sha256_digest(data.data(), data.size());
+
+    // Any split of the input gives the same digest
+    for (size_t step : {1, 3, 63, 64, 65, 500}) {
+        Sha256Context ctx;
+        for (size_t i = 0; i < data.size(); i += step) {
+            ctx.update(data.data() + i, std::min(step, data.size() - i));
+        }
+        Digest digest;
+        ctx.final(digest);
+        CHECK(digest == expected);
+    }
+
+    // Saved part-way and finished by another context
+    for (size_t split : {0, 1, 64, 100, 999}) {
+        Sha256Context first;
+        first.update(data.data(), split);
+        std::vector<uint8_t> saved = first.save();
+        CHECK(saved.size() <= Sha256Context::kSavedMax);
+
+        Sha256Context second;
+        CHECK(second.load(saved.data(), saved.size()));
+        second.update(data.data() + split, data.size() - split);
+        Digest digest;
+        second.final(digest);
+        CHECK(digest == expected);
+    }
+
+    // Malformed state is rejected and leaves the context as it was
+    Sha256Context ctx;
+    ctx.update(bytes_of("ab"), 2);
+    std::vector<uint8_t> saved = ctx.save();
+    CHECK(!ctx.load(saved.data(), saved.size() - 1));
+    std::vector<uint8_t> bad = saved;
+    bad[0] = 'X';
+    CHECK(!ctx.load(bad.data(), bad.size()));
+    ctx.update(bytes_of("c"), 1);
+    CHECK(ctx.final() == sha256("abc"));
+}
+
+// ============ Batch Hashing ============
+
+void test_batch() {
+    std::vector<std::vector<uint8_t>> messages;
+    for (size_t length = 0; length < 200; length += 5) {
+        messages.push_back(random_bytes(length, static_cast<uint32_t>(length)));
+    }
+    std::vector<ByteView> in;
+    for (const auto& m : messages) in.push_back({m.data(), m.size()});
+
+    std::vector<Digest> out(in.size());
+    sha256_batch(in.data(), out.data(), in.size());
+    for (size_t i = 0; i < in.size(); i++) {
+        CHECK(out[i] == sha256_digest(in[i].data, in[i].size));
+    }
+}
+
+// ============ HMAC (RFC 4231) ============
+
+void test_hmac() {
+    HmacSha256 case1(std::string(20, '\x0b'));
+    CHECK(to_hex(case1.mac("Hi There")) ==
+          "b0344c61d8db38535ca8afceaf0bf12b881dc200c9833da726e9376c2e32cff7");
+
+    HmacSha256 case2("Jefe");
+    Digest tag = case2.mac("what do ya want for nothing?");
+    CHECK(to_hex(tag) == "5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843");
+    std::string message = "what do ya want for nothing?";
+    CHECK(case2.verify(bytes_of(message), message.size(), tag));
+    tag[31] ^= 1;
+    CHECK(!case2.verify(bytes_of(message), message.size(), tag));
+
+    HmacSha256 case6(std::string(131, '\xaa'));
+    CHECK(to_hex(case6.mac("Test Using Larger Than Block-Size Key - Hash Key First")) ==
+          "60e431591ee0b67f0d8a26aacbf5b77f8e0bc6213728c5140546040f0ee37f54");
+
+    // The batch path gives the same tags
+    std::vector<std::string> messages = {"", "Hi There", std::string(200, 'x')};
+    std::vector<ByteView> in;
+    for (const auto& m : messages) in.push_back({bytes_of(m), m.size()});
+    std::vector<Digest> out(in.size());
+    case1.mac_batch(in.data(), out.data(), in.size());
+    for (size_t i = 0; i < in.size(); i++) {
+        CHECK(out[i] == case1.mac(messages[i]));
+    }
+}
+
+// ============ HKDF (RFC 5869) ============
+
+void test_hkdf() {
+    std::vector<uint8_t> ikm(22, 0x0b);
+    uint8_t salt[13], info[10], okm[42];
+    for (int i = 0; i < 13; i++) salt[i] = static_cast<uint8_t>(i);
+    for (int i = 0; i < 10; i++) info[i] = static_cast<uint8_t>(0xf0 + i);
+
+    CHECK(hkdf_sha256(salt, sizeof(salt), ikm.data(), ikm.size(), info, sizeof(info), okm, 42));
+    CHECK(hex_of(okm, 42) == "3cb25f25faacd57a90434f64d0362f2a2d2d0a90cf1a5a4c5db02d56ecc4c5bf"
+                             "34007208d5b887185865");
+
+    // Test case 3: no salt, no info
+    CHECK(hkdf_sha256(nullptr, 0, ikm.data(), ikm.size(), nullptr, 0, okm, 42));
+    CHECK(hex_of(okm, 42) == "8da4e775a563c18f715f802a063c5a31b8a11f5c5ee1879ec3454e5f3c738d2d"
+                             "9d201395faa4b61a96c8");
+
+    std::vector<uint8_t> too_long(255 * 32 + 1);
+    HkdfSha256 kdf(salt, sizeof(salt), ikm.data(), ikm.size());
+    CHECK(kdf.expand(info, sizeof(info), too_long.data(), 255 * 32));
+    CHECK(!kdf.expand(info, sizeof(info), too_long.data(), too_long.size()));
+}
+
+// ============ PBKDF2 (RFC 7914 section 11) ============
+
+void test_pbkdf2() {
+    uint8_t out[64];
+    CHECK(pbkdf2_sha256(bytes_of("passwd"), 6, bytes_of("salt"), 4, 1, out, 64));
+    CHECK(hex_of(out, 64) == "55ac046e56e3089fec1691c22544b605f94185216dde0465e68b9d57c20dacbc"
+                             "49ca9cccf179b645991664b39d77ef317c71b845b1e30bd509112041d3a19783");
+
+    CHECK(pbkdf2_sha256(bytes_of("Password"), 8, bytes_of("NaCl"), 4, 80000, out, 64));
+    CHECK(hex_of(out, 64) == "4ddcd8f60b98be21830cee5ef22701f9641a4418d04c0414aeff08876b34ab56"
+                             "a1d425a1225833549adb841b51c9b3176a272bdebba1d078478f62b397f33c8d");
+
+    CHECK(!pbkdf2_sha256(bytes_of("passwd"), 6, bytes_of("salt"), 4, 0, out, 64));
+
+    // The batch path gives each candidate its own key
+    std::vector<std::string> passwords = {"passwd", "", "Password", std::string(100, 'p')};
+    std::vector<ByteView> in;
+    for (const auto& p : passwords) in.push_back({bytes_of(p), p.size()});
+    std::vector<uint8_t> batch(passwords.size() * 40);
+    CHECK(pbkdf2_sha256_batch(in.data(), in.size(), bytes_of("salt"), 4, 3, batch.data(), 40));
+    for (size_t i = 0; i < passwords.size(); i++) {
+        uint8_t single[40];
+        CHECK(pbkdf2_sha256(in[i].data, in[i].size, bytes_of("salt"), 4, 3, single, 40));
+        CHECK(std::memcmp(single, batch.data() + i * 40, 40) == 0);
+    }
+}
+
+// ============ Merkle Trees ============
+
+void test_merkle() {
+    std::vector<Digest> leaves;
+    for (int i = 0; i < 9; i++) leaves.push_back(sha256_digest(std::to_string(i)));
+
+    // Two leaves: the root is sha256d of both
+    uint8_t pair[64];
+    std::copy(leaves[0].begin(), leaves[0].end(), pair);
+    std::copy(leaves[1].begin(), leaves[1].end(), pair + 32);
+    CHECK(merkle_root(leaves.data(), 2) == sha256d(pair, 64));
+
+    for (size_t count = 1; count <= leaves.size(); count++) {
+        MerkleTree tree(leaves.data(), count);
+        CHECK(tree.leaves() == count);
+        CHECK(tree.root() == merkle_root(leaves.data(), count));
+
+        for (size_t i = 0; i < count; i++) {
+            std::vector<Digest> proof = tree.proof(i);
+            CHECK(merkle_verify(leaves[i], i, proof, tree.root()));
+            CHECK(!merkle_verify(leaves[(i + 1) % leaves.size()], i, proof, tree.root()));
+        }
+        CHECK(tree.proof(count).empty());
+    }
+}
+
+// ============ Chunking and Tree Hashing ============
+
+void test_cdc() {
+    CdcParams params;
+    CHECK(params.valid());
+    params.avg_size = 3000;
+    CHECK(!params.valid());
+    params = CdcParams();
+    params.min_size = params.avg_size * 2;
+    CHECK(!params.valid());
+
+    // The chunks cover the stream and each digest is its chunk's
+    std::vector<uint8_t> data = random_bytes(200000, 3);
+    std::string text(data.begin(), data.end());
+    std::istringstream in(text);
+    uint64_t covered = 0;
+    CHECK(sha256_cdc(in, CdcParams(), 2, [&](const ChunkRecord& chunk) {
+        CHECK(chunk.offset == covered);
+        CHECK(chunk.digest == sha256_digest(data.data() + chunk.offset, chunk.length));
+        covered += chunk.length;
+    }));
+    CHECK(covered == data.size());
+}
+
+void test_tree() {
+    std::vector<uint8_t> data = random_bytes(300000, 4);
+    Digest one, four;
+    CHECK(sha256_tree(data.data(), data.size(), 65536, 1, one));
+    CHECK(sha256_tree(data.data(), data.size(), 65536, 4, four));
+    CHECK(one == four);
+    CHECK(!sha256_tree(data.data(), data.size(), 0, 1, one));
+    CHECK(sha256_tree_name(kTreeChunkDefault) == "SHA256-TREE-1M");
+    CHECK(sha256_tree_name(0).empty());
+}
+
+// ============ Trace ============
+
+void test_trace() {
+    std::vector<uint8_t> data = random_bytes(150, 5);
+    Sha256Trace trace;
+    trace.record(data.data(), data.size());
+    CHECK(trace.digest() == sha256_digest(data.data(), data.size()));
+    CHECK(trace.message() == data);
+
+    std::vector<uint8_t> saved = trace.save();
+    Sha256Trace loaded;
+    CHECK(loaded.load(saved.data(), saved.size()));
+    CHECK(loaded.digest() == trace.digest());
+    saved.back() ^= 1;
+    CHECK(!loaded.load(saved.data(), saved.size()));
+
+    // A header claiming a length near 2^64 and no blocks
+    std::vector<uint8_t> huge = {'S', '2', '5', 'T', 1};
+    for (int i = 0; i < 7; i++) huge.push_back(0xff);
+    huge.push_back(0xf0);
+    for (int i = 0; i < 4; i++) huge.push_back(0);
+    CHECK(!loaded.load(huge.data(), huge.size()));
+    CHECK(loaded.digest() == trace.digest());
+}
+
+} // namespace
+
+// ============ Main ============
+
+int main() {
+    std::cout << "backend " << sha256_backend_name(sha256_get_backend())
+              << ", " << sha256_batch_lanes() << " lane(s)" << std::endl;
+
+    const std::pair<const char*, void (*)()> tests[] = {
+        {"sha256", test_sha256},   {"backends", test_backends}, {"context", test_context},
+        {"batch", test_batch},     {"hmac", test_hmac},         {"hkdf", test_hkdf},
+        {"pbkdf2", test_pbkdf2},   {"merkle", test_merkle},     {"cdc", test_cdc},
+        {"tree", test_tree},       {"trace", test_trace},
+    };
+    for (const auto& test : tests) {
+        int before = g_failures;
+        test.second();
+        std::cout << (g_failures == before ? "ok   " : "FAIL ") << test.first << std::endl;
+    }
+
+    if (g_failures) {
+        std::cout << g_failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+    return 0;
+}
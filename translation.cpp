@@ -8,58 +8,26 @@
 #include <chrono>
 #include <cmath>
 #include <cstdint>
+#include <array>
+#include <algorithm>
 #include <fstream>
+#include <cstdlib>
+
+#include "SHA.h"
 
 // ============ Global Variables ============
 std::string g_input = "abc";
 std::string g_type = "string";
 std::vector<uint8_t> g_bytes;
-std::string g_message;
-std::string g_padded;
-std::vector<std::string> g_blocks;
-std::vector<uint32_t> g_hash;
+Sha256Trace g_trace;
+std::array<uint32_t, 8> g_hash;
 std::string g_digest;
 std::string g_state;
-std::string g_delay = "normal";
+bool g_overview = false;       // too long to show bit by bit
+size_t g_selected = 0;         // block expanded in the overview
 
 // ============ Utility Functions ============
 
-void clearScreen() {
-    std::cout << "\033[2J\033[1;1H";
-}
-
-void delay(const std::string& speed) {
-    if (g_delay == "enter") {
-        std::cin.get();
-    } else if (g_delay == "nodelay") {
-        std::this_thread::sleep_for(std::chrono::milliseconds(0));
-    } else {
-        double multiplier = 1.0;
-        if (g_delay == "fast") multiplier = 0.5;
-        
-        int sleepTime = 0;
-        if (speed == "fastest") sleepTime = 100 * multiplier;
-        else if (speed == "fast") sleepTime = 200 * multiplier;
-        else if (speed == "normal") sleepTime = 400 * multiplier;
-        else if (speed == "slow") sleepTime = 600 * multiplier;
-        else if (speed == "slowest") sleepTime = 800 * multiplier;
-        else if (speed == "end") sleepTime = 1000 * multiplier;
-        
-        std::this_thread::sleep_for(std::chrono::milliseconds(sleepTime));
-    }
-}
-
-std::string bits(uint32_t x, int n = 32) {
-    std::string binary = std::bitset<32>(x).to_string();
-    return binary.substr(32 - n, n);
-}
-
-std::string hex(uint32_t i) {
-    std::stringstream ss;
-    ss << std::hex << std::setfill('0') << std::setw(8) << i;
-    return ss.str();
-}
-
 std::string bytesToHex(const std::vector<uint8_t>& bytes) {
     std::stringstream ss;
     ss << std::hex << std::setfill('0');
@@ -71,8 +39,9 @@ std::string bytesToHex(const std::vector<uint8_t>& bytes) {
 
 std::string bytesToBinary(const std::vector<uint8_t>& bytes) {
     std::string result;
-    for (uint8_t byte : bytes) {
-        result += std::bitset<8>(byte).to_string();
+    for (size_t i = 0; i < bytes.size(); i++) {
+        result += std::bitset<8>(bytes[i]).to_string();
+        if (i < bytes.size() - 1) result += " ";
     }
     return result;
 }
@@ -88,170 +57,39 @@ std::string bytesInspect(const std::vector<uint8_t>& bytes) {
     return ss.str();
 }
 
-// ============ SHA-256 Operations ============
-
-uint32_t rotr(int n, uint32_t x) {
-    return (x >> n) | (x << (32 - n));
-}
-
-uint32_t shr(int n, uint32_t x) {
-    return x >> n;
+// In the overview a long value is cut to fit on the line after its label
+std::string fit(const std::string& text, size_t label) {
+    if (!g_overview) return text;
+    int width, height;
+    frame_renderer().size(width, height);
+    return elide(text, static_cast<size_t>(width) > label ? width - label : 1);
 }
 
-uint32_t sigma0(uint32_t x) {
-    return rotr(7, x) ^ rotr(18, x) ^ shr(3, x);
-}
-
-uint32_t sigma1(uint32_t x) {
-    return rotr(17, x) ^ rotr(19, x) ^ shr(10, x);
-}
-
-uint32_t usigma0(uint32_t x) {
-    return rotr(2, x) ^ rotr(13, x) ^ rotr(22, x);
-}
-
-uint32_t usigma1(uint32_t x) {
-    return rotr(6, x) ^ rotr(11, x) ^ rotr(25, x);
-}
-
-uint32_t ch(uint32_t x, uint32_t y, uint32_t z) {
-    return (x & y) ^ ((~x) & z);
-}
-
-uint32_t maj(uint32_t x, uint32_t y, uint32_t z) {
-    return (x & y) ^ (x & z) ^ (y & z);
-}
-
-uint32_t add(uint32_t a, uint32_t b) {
-    return (a + b) & 0xFFFFFFFF;
-}
-
-uint32_t add(uint32_t a, uint32_t b, uint32_t c) {
-    return (a + b + c) & 0xFFFFFFFF;
-}
-
-uint32_t add(uint32_t a, uint32_t b, uint32_t c, uint32_t d) {
-    uint64_t total = static_cast<uint64_t>(a) + b + c + d;
-    return static_cast<uint32_t>(total & 0xFFFFFFFF);
-}
-
-uint32_t add(uint32_t a, uint32_t b, uint32_t c, uint32_t d, uint32_t e) {
-    uint64_t total = static_cast<uint64_t>(a) + b + c + d + e;
-    return static_cast<uint32_t>(total & 0xFFFFFFFF);
-}
-
-// ============ SHA-256 Constants ============
-
-std::vector<uint32_t> calculateK() {
-    std::vector<uint32_t> constants;
-    int primes[] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53, 
-                    59, 61, 67, 71, 73, 79, 83, 89, 97, 101, 103, 107, 109, 113, 
-                    127, 131, 137, 139, 149, 151, 157, 163, 167, 173, 179, 181, 
-                    191, 193, 197, 199, 211, 223, 227, 229, 233, 239, 241, 251, 
-                    257, 263, 269, 271, 277, 281, 283, 293, 307, 311};
-    
-    for (int prime : primes) {
-        double cubeRoot = std::pow(prime, 1.0 / 3.0);
-        double fractional = cubeRoot - std::floor(cubeRoot);
-        uint32_t value = static_cast<uint32_t>(fractional * std::pow(2, 32));
-        constants.push_back(value);
-    }
-    return constants;
-}
-
-std::vector<uint32_t> calculateIV() {
-    std::vector<uint32_t> initial;
-    int primes[] = {2, 3, 5, 7, 11, 13, 17, 19};
-    
-    for (int prime : primes) {
-        double squareRoot = std::sqrt(prime);
-        double fractional = squareRoot - std::floor(squareRoot);
-        uint32_t value = static_cast<uint32_t>(fractional * std::pow(2, 32));
-        initial.push_back(value);
-    }
-    return initial;
-}
-
-const std::vector<uint32_t> K = calculateK();
-const std::vector<uint32_t> IV = calculateIV();
-
-// ============ SHA-256 Core Functions ============
-
-std::string padding(const std::string& message) {
-    size_t l = message.size();
-    int k = (448 - static_cast<int>(l) - 1) % 512;
-    if (k < 0) k += 512;
-    
-    std::string l64 = bits(l, 64);
-    return message + "1" + std::string(k, '0') + l64;
-}
-
-std::vector<std::string> split(const std::string& message, int size = 512) {
-    std::vector<std::string> blocks;
-    for (size_t i = 0; i < message.length(); i += size) {
-        blocks.push_back(message.substr(i, size));
-    }
-    return blocks;
-}
-
-std::vector<uint32_t> calculate_schedule(const std::string& block) {
-    std::vector<uint32_t> schedule;
-
-    for (size_t i = 0; i < 16; i++) {
-        std::string word = block.substr(i * 32, 32);
-        schedule.push_back(std::bitset<32>(word).to_ulong());
-    }
-
-    for (int i = 16; i <= 63; i++) {
-        schedule.push_back(add(sigma1(schedule[i - 2]), 
-                               schedule[i - 7], 
-                               sigma0(schedule[i - 15]), 
-                               schedule[i - 16]));
-    }
-    return schedule;
-}
-
-std::vector<uint32_t> compression(const std::vector<uint32_t>& initial, 
-                                  const std::vector<uint32_t>& schedule) {
-    uint32_t h = initial[7];
-    uint32_t g = initial[6];
-    uint32_t f = initial[5];
-    uint32_t e = initial[4];
-    uint32_t d = initial[3];
-    uint32_t c = initial[2];
-    uint32_t b = initial[1];
-    uint32_t a = initial[0];
-
-    for (int i = 0; i < 64; i++) {
-        uint32_t t1 = add(schedule[i], K[i], usigma1(e), ch(e, f, g), h);
-        uint32_t t2 = add(usigma0(a), maj(a, b, c));
-
-        h = g;
-        g = f;
-        f = e;
-        e = add(d, t1);
-        d = c;
-        c = b;
-        b = a;
-        a = add(t1, t2);
-    }
-
-    std::vector<uint32_t> hash(8);
-    hash[7] = add(initial[7], h);
-    hash[6] = add(initial[6], g);
-    hash[5] = add(initial[5], f);
-    hash[4] = add(initial[4], e);
-    hash[3] = add(initial[3], d);
-    hash[2] = add(initial[2], c);
-    hash[1] = add(initial[1], b);
-    hash[0] = add(initial[0], a);
-
-    return hash;
+// The same for the formatted message: the overview formats only the
+// bytes at either end; `total` is the length of the whole text
+std::string fitBytes(std::string (*format)(const std::vector<uint8_t>&), uint64_t total, size_t label) {
+    if (!g_overview) return format(g_bytes);
+    int width, height;
+    frame_renderer().size(width, height);
+    size_t ends = std::min(static_cast<size_t>(width), g_bytes.size());
+    std::string head = format(std::vector<uint8_t>(g_bytes.begin(), g_bytes.begin() + ends));
+    std::string tail = format(std::vector<uint8_t>(g_bytes.end() - ends, g_bytes.end()));
+    return elide(head, tail, total, static_cast<size_t>(width) > label ? width - label : 1);
 }
 
 // ============ Message Visualization ============
 
 void showMessage() {
+    std::string input = fit(g_input, 11 + g_type.size() + 3);
+
+    // Lengths of the whole texts, which the overview never builds
+    uint64_t n = g_bytes.size();
+    uint64_t digits = 0;
+    for (uint8_t byte : g_bytes) digits += byte >= 100 ? 3 : byte >= 10 ? 2 : 1;
+    std::string inspect = fitBytes(bytesInspect, n ? digits + 2 * n : 2, 9);
+    std::string binary = fitBytes(bytesToBinary, n ? 9 * n - 1 : 0, 9);
+    std::string hexed = fitBytes(bytesToHex, 2 * n, 11);
+
     // Frame 1: Simple title
     clearScreen();
     std::cout << "========================" << std::endl;
@@ -270,7 +108,7 @@ void showMessage() {
     std::cout << "-------" << std::endl;
     std::cout << "message:" << std::endl;
     std::cout << "-------" << std::endl;
-    std::cout << "input:   \"" << g_input << "\" (" << g_type << ")" << std::endl;
+    std::cout << "input:   \"" << input << "\" (" << g_type << ")" << std::endl;
     delay("normal");
     
     // Frame 3: Add bytes
@@ -281,8 +119,8 @@ void showMessage() {
     std::cout << "-------" << std::endl;
     std::cout << "message:" << std::endl;
     std::cout << "-------" << std::endl;
-    std::cout << "input:   \"" << g_input << "\" (" << g_type << ")" << std::endl;
-    std::cout << "bytes:   " << bytesInspect(g_bytes) << std::endl;
+    std::cout << "input:   \"" << input << "\" (" << g_type << ")" << std::endl;
+    std::cout << "bytes:   " << inspect << std::endl;
     delay("normal");
     
     // Frame 4: Add binary message
@@ -293,19 +131,14 @@ void showMessage() {
     std::cout << "-------" << std::endl;
     std::cout << "message:" << std::endl;
     std::cout << "-------" << std::endl;
-    std::cout << "input:   \"" << g_input << "\" (" << g_type << ")" << std::endl;
-    std::cout << "bytes:   " << bytesInspect(g_bytes) << std::endl;
+    std::cout << "input:   \"" << input << "\" (" << g_type << ")" << std::endl;
+    std::cout << "bytes:   " << inspect << std::endl;
     
     // Show binary with byte grouping
-    std::cout << "message: ";
-    for (size_t i = 0; i < g_bytes.size(); i++) {
-        std::cout << std::bitset<8>(g_bytes[i]).to_string();
-        if (i < g_bytes.size() - 1) std::cout << " ";
-    }
-    std::cout << std::endl;
+    std::cout << "message: " << binary << std::endl;
     
     // Show hex representation
-    std::cout << "hex:     0x" << bytesToHex(g_bytes) << std::endl;
+    std::cout << "hex:     0x" << hexed << std::endl;
     delay("end");
 }
 
@@ -317,8 +150,8 @@ void showPadding() {
     std::cout << "STEP 2: Message Padding" << std::endl;
     std::cout << "========================" << std::endl;
     
-    size_t original_len = g_message.length();
-    size_t padded_len = g_padded.length();
+    size_t original_len = g_bytes.size() * 8;
+    size_t padded_len = padded_blocks(g_bytes.size()) * 512;
     
     std::cout << "Original message length: " << original_len << " bits" << std::endl;
     std::cout << "Padded message length:   " << padded_len << " bits" << std::endl;
@@ -331,41 +164,81 @@ void showPadding() {
     
     // Show first part of padded message
     std::cout << "Padded message (first 64 bits):" << std::endl;
-    std::cout << "  " << g_padded.substr(0, 64) << "..." << std::endl;
+    std::cout << "  " << padded_bits(g_bytes.data(), g_bytes.size(), 0, 64) << "..." << std::endl;
     
     delay("slow");
 }
 
 // ============ Blocks Visualization ============
 
-void showBlocks() {
+void showBlocks(const Sha256Trace& trace) {
     clearScreen();
     std::cout << "========================" << std::endl;
     std::cout << "STEP 3: Message Blocks" << std::endl;
     std::cout << "========================" << std::endl;
-    std::cout << g_blocks.size() << " block(s) of 512 bits" << std::endl;
+    std::cout << trace.blocks() << " block(s) of 512 bits" << std::endl;
     std::cout << std::endl;
     
-    for (size_t i = 0; i < g_blocks.size(); i++) {
+    for (size_t i = 0; i < trace.blocks(); i++) {
         std::cout << "Block " << i << ":" << std::endl;
-        std::string block = g_blocks[i];
+        const uint32_t* w = trace.schedule(i);
         
         // Show block as 16 words of 32 bits
         for (int j = 0; j < 16; j++) {
             std::cout << "  W" << std::setw(2) << j << ": " 
-                      << block.substr(j * 32, 32);
+                      << std::bitset<32>(w[j]).to_string();
             if (j == 3 || j == 7 || j == 11) std::cout << std::endl;
             else std::cout << "  ";
         }
         std::cout << std::endl;
         
-        if (i < g_blocks.size() - 1) {
+        if (i < trace.blocks() - 1) {
             std::cout << "---" << std::endl;
         }
     }
     delay("slow");
 }
 
+// ============ Block Overview ============
+
+// One shaded cell per run of blocks instead of every block's bits; only
+// the selected block's words are printed
+void showBlockOverview(const TraceOverview& overview, const Sha256Trace& trace) {
+    int width, height;
+    frame_renderer().size(width, height);
+
+    clearScreen();
+    std::cout << "========================" << std::endl;
+    std::cout << "STEP 3: Message Blocks (overview)" << std::endl;
+    std::cout << "========================" << std::endl;
+    std::cout << overview.blocks() << " blocks of 512 bits, block " << g_selected << " selected" << std::endl;
+    std::cout << std::endl;
+    std::cout << overview.block_map(width, std::max(1, height / 4), g_selected);
+    std::cout << std::endl;
+    
+    std::cout << "Block " << g_selected << ":" << std::endl;
+    const uint32_t* w = trace.schedule(g_selected);
+    for (int j = 0; j < 16; j++) {
+        std::cout << "  W" << std::setw(2) << j << ": " 
+                  << std::bitset<32>(w[j]).to_string();
+        if (j % 4 == 3) std::cout << std::endl;
+        else std::cout << "  ";
+    }
+    delay("slow");
+}
+
+void showRoundOverview(const TraceOverview& overview, size_t block_num) {
+    clearScreen();
+    std::cout << "========================" << std::endl;
+    std::cout << "STEP 6: Compression (Block " << block_num << " of " << overview.blocks() << ")" << std::endl;
+    std::cout << "========================" << std::endl;
+    std::cout << "Bits flipped per register and round:" << std::endl;
+    std::cout << overview.round_map(block_num);
+    std::cout << std::endl;
+    std::cout << "Total: " << overview.block_flips(block_num) << " bits" << std::endl;
+    delay("slow");
+}
+
 // ============ Initial Hash Visualization ============
 
 void showInitialHash() {
@@ -414,7 +287,7 @@ void showSchedule(const std::vector<uint32_t>& schedule, int block_num) {
 
 // ============ Compression Round Visualization ============
 
-void showCompressionRound(const std::vector<uint32_t>& hash, int round, int total_rounds) {
+void showCompressionRound(const TraceRound& state, int round, int total_rounds) {
     clearScreen();
     std::cout << "========================" << std::endl;
     std::cout << "STEP 6: Compression - Round " << round << "/" << total_rounds << std::endl;
@@ -423,9 +296,11 @@ void showCompressionRound(const std::vector<uint32_t>& hash, int round, int tota
     std::string registers[] = {"a", "b", "c", "d", "e", "f", "g", "h"};
     
     for (int i = 0; i < 8; i++) {
-        std::cout << registers[i] << " = " << bits(hash[i]) 
-                  << " (0x" << hex(hash[i]) << ")" << std::endl;
+        std::cout << registers[i] << " = " << bits(state.reg[i]) 
+                  << " (0x" << hex(state.reg[i]) << ")" << std::endl;
     }
+    std::cout << "T1 = " << bits(state.t1) << " (0x" << hex(state.t1) << ")" << std::endl;
+    std::cout << "T2 = " << bits(state.t2) << " (0x" << hex(state.t2) << ")" << std::endl;
     
     delay("fast");
 }
@@ -473,48 +348,71 @@ void showFinalHash() {
     delay("end");
 }
 
+// ============ Block Replay ============
+
+void showBlockSchedule(const Sha256Trace& trace, size_t block_num) {
+    const uint32_t* w = trace.schedule(block_num);
+    showSchedule(std::vector<uint32_t>(w, w + 64), block_num);
+}
+
+// Sample compression rounds
+void showSampleRounds(const Sha256Trace& trace, size_t block_num) {
+    for (int round = 0; round < 64; round += 16) {
+        showCompressionRound(trace.round(block_num, round), round, 64);
+    }
+}
+
 // ============ Main SHA-256 Function ============
 
-std::string sha256(const std::string& input) {
+std::string animateSha256(const std::string& input) {
     g_input = input;
-    g_bytes.clear();
-    for (char c : g_input) {
-        g_bytes.push_back(static_cast<uint8_t>(c));
+    if (g_type == "string") {
+        g_bytes.clear();
+        for (char c : g_input) {
+            g_bytes.push_back(static_cast<uint8_t>(c));
+        }
+    }
+
+    // Messages larger than the screen are summarised per block
+    g_overview = overview_needed(g_bytes.size());
+    g_selected = std::min<size_t>(g_selected, padded_blocks(g_bytes.size()) - 1);
+
+    // Run the whole computation up front, unless a saved trace was given;
+    // the frames below only replay it. The overview keeps only the
+    // selected block in full (800 bytes) and a 4-byte count for the rest
+    const Sha256Trace& trace = g_trace;
+    if (g_type != "trace") {
+        if (g_overview) g_trace.record(g_bytes.data(), g_bytes.size(), g_selected, 1);
+        else g_trace.record(g_bytes.data(), g_bytes.size());
     }
-    g_message = bytesToBinary(g_bytes);
     
     // Show message visualization
     showMessage();
     
     // Padding
-    g_padded = padding(g_message);
     showPadding();
     
-    // Split into blocks
-    g_blocks = split(g_padded, 512);
-    showBlocks();
-    
     // Initialize hash
-    g_hash = IV;
-    showInitialHash();
-    
-    // Process each block
-    for (size_t block_num = 0; block_num < g_blocks.size(); block_num++) {
-        // Calculate message schedule
-        std::vector<uint32_t> schedule = calculate_schedule(g_blocks[block_num]);
-        showSchedule(schedule, block_num);
-        
-        // Remember starting hash
-        std::vector<uint32_t> initial = g_hash;
-        
-        // Show compression rounds (just a few samples)
-        for (int round = 0; round < 64; round += 16) {
-            showCompressionRound(g_hash, round, 64);
+    std::copy(IV.begin(), IV.end(), g_hash.begin());
+    
+    // Blocks, then each block replayed from the trace. The overview only
+    // expands the selected block
+    if (g_overview) {
+        TraceOverview overview(trace);
+        showBlockOverview(overview, trace);
+        showInitialHash();
+        showBlockSchedule(trace, g_selected);
+        showRoundOverview(overview, g_selected);
+        showSampleRounds(trace, g_selected);
+    } else {
+        showBlocks(trace);
+        showInitialHash();
+        for (size_t block_num = 0; block_num < trace.blocks(); block_num++) {
+            showBlockSchedule(trace, block_num);
+            showSampleRounds(trace, block_num);
         }
-        
-        // Apply compression
-        g_hash = compression(initial, schedule);
     }
+    g_hash = trace.final_state();
     
     // Show final hash
     showFinalHash();
@@ -525,13 +423,42 @@ std::string sha256(const std::string& input) {
 // ============ Main ============
 
 int main(int argc, char* argv[]) {
-    // Parse command line arguments
-    if (argc >= 2) {
-        g_input = argv[1];
+    // Parse command line arguments; "--trace FILE" replays a trace saved
+    // by sha_program --trace in place of the input
+    int first = 1;
+    if (argc >= 3 && std::string(argv[1]) == "--trace") {
+        g_type = "trace";
+        first = 2;
+    }
+    
+    if (argc > first) {
+        g_input = argv[first];
     }
     
-    if (argc >= 3) {
-        g_delay = argv[2];
+    if (argc > first + 1) {
+        g_delay = argv[first + 1];
+    }
+    
+    // Block to expand when the message is shown as an overview
+    if (argc > first + 2) {
+        g_selected = std::strtoul(argv[first + 2], nullptr, 10);
+    }
+    
+    // A file is hashed by its contents; the path stays as the label
+    std::ifstream file(g_input, std::ios::binary);
+    if (g_type == "trace") {
+        std::vector<uint8_t> saved;
+        if (file.good()) {
+            saved.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        }
+        if (!g_trace.load(saved.data(), saved.size())) {
+            std::cerr << "Not a valid trace: " << g_input << std::endl;
+            return 1;
+        }
+        g_bytes = g_trace.message();
+    } else if (file.good()) {
+        g_type = "file";
+        g_bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
     }
     
     // Note about hitting enter to step
@@ -540,8 +467,11 @@ int main(int argc, char* argv[]) {
         std::cin.get();
     }
     
+    // Compose each frame in memory; only the changed cells are redrawn
+    frame_renderer().attach();
+
     // Run the complete SHA-256 visualization
-    std::string result = sha256(g_input);
+    std::string result = animateSha256(g_input);
     
     return 0;
 }
@@ -4,29 +4,14 @@
 #include <chrono>
 #include <cstdlib>
 
-using namespace std;
-
-// --- Utility functions ---
-string bits(uint32_t x) {
-    return bitset<32>(x).to_string();
-}
-
-uint32_t rotr(int n, uint32_t x) {
-    return (x >> n) | (x << (32 - n));
-}
+#include "SHA.h"
 
-uint32_t shr(int n, uint32_t x) {
-    return x >> n;
-}
+using namespace std;
 
 void clear_screen() {
     system("clear"); // works on Linux
 }
 
-void sleep_ms(int ms) {
-    this_thread::sleep_for(chrono::milliseconds(ms));
-}
-
 // --- Animation for σ0(x) ---
 void animate_sigma0(uint32_t x) {
     clear_screen();
@@ -37,7 +22,7 @@ void animate_sigma0(uint32_t x) {
          << " SHR 3:  " << bits(x) << "\n"
          << "         " << string(32, '-') << "\n"
          << "σ0(x):\n";
-    sleep_ms(100);
+    delay(100);
 
     // ROTR(7, x)
     for (int i = 0; i <= 7; i++) {
@@ -49,7 +34,7 @@ void animate_sigma0(uint32_t x) {
              << " SHR 3:  " << bits(x) << "\n"
              << "         " << string(32, '-') << "\n"
              << "σ0(x):\n";
-        sleep_ms(100);
+        delay(100);
     }
 
     // ROTR(18, x)
@@ -62,7 +47,7 @@ void animate_sigma0(uint32_t x) {
              << " SHR 3:  " << bits(x) << "\n"
              << "         " << string(32, '-') << "\n"
              << "σ0(x):\n";
-        sleep_ms(100);
+        delay(100);
     }
 
     // SHR(3, x)
@@ -75,7 +60,7 @@ void animate_sigma0(uint32_t x) {
              << " SHR 3:  " << bits(shr(i, x)) << "\n"
              << "         " << string(32, '-') << "\n"
              << "σ0(x):\n";
-        sleep_ms(100);
+        delay(100);
     }
 
     // Final XOR
@@ -89,9 +74,9 @@ void animate_sigma0(uint32_t x) {
              << " SHR 3:  " << bits(shr(3, x)) << " XOR\n"
              << "         " << string(32, '-') << "\n"
              << "σ0(x):   " << bits(result).substr(32 - i) << "\n";
-        sleep_ms(100);
+        delay(100);
     }
-    sleep_ms(1000);
+    delay(1000);
 }
 
 // --- Animation for σ1(x) ---
@@ -104,7 +89,7 @@ void animate_sigma1(uint32_t x) {
          << " SHR 10: " << bits(x) << "\n"
          << "         " << string(32, '-') << "\n"
          << "σ1(x):\n";
-    sleep_ms(100);
+    delay(100);
 
     // ROTR(17, x)
     for (int i = 0; i <= 17; i++) {
@@ -116,7 +101,7 @@ void animate_sigma1(uint32_t x) {
              << " SHR 10: " << bits(x) << "\n"
              << "         " << string(32, '-') << "\n"
              << "σ1(x):\n";
-        sleep_ms(100);
+        delay(100);
     }
 
     // ROTR(19, x)
@@ -129,7 +114,7 @@ void animate_sigma1(uint32_t x) {
              << " SHR 10: " << bits(x) << "\n"
              << "         " << string(32, '-') << "\n"
              << "σ1(x):\n";
-        sleep_ms(100);
+        delay(100);
     }
 
     // SHR(10, x)
@@ -142,7 +127,7 @@ void animate_sigma1(uint32_t x) {
              << " SHR 10: " << bits(shr(i, x)) << "\n"
              << "         " << string(32, '-') << "\n"
              << "σ1(x):\n";
-        sleep_ms(100);
+        delay(100);
     }
 
     // Final XOR
@@ -156,9 +141,9 @@ void animate_sigma1(uint32_t x) {
              << " SHR 10: " << bits(shr(10, x)) << " XOR\n"
              << "         " << string(32, '-') << "\n"
              << "σ1(x):   " << bits(result).substr(32 - i) << "\n";
-        sleep_ms(100);
+        delay(100);
     }
-    sleep_ms(1000);
+    delay(1000);
 }
 
 // --- Main driver ---